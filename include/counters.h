@@ -0,0 +1,51 @@
+#ifndef INCLUDE_COUNTERS_H_
+#define INCLUDE_COUNTERS_H_
+
+#include <cstdint>
+#include <vector>
+#include "memory.h"
+
+/**
+ * @file
+ * @brief Performance counters of the virtual machine.
+ */
+
+namespace mixal {
+
+/** Statistics collected while executing the codes.
+ *
+ * The histogram of instructions is only collected when the counters are enabled,
+ * the other counters are always collected.
+ */
+struct PerformanceCounters {
+    static constexpr int NUM_OPERATIONS = BYTE_SIZE;  /**< Number of operation codes. */
+    static constexpr int NUM_FIELDS = BYTE_SIZE;      /**< Number of field values. */
+
+    int64_t steps = 0;          /**< Number of executed instructions. */
+    int64_t elapsed = 0;        /**< Number of elapsed unit time. */
+    /** Number of executed instructions indexed by `operation * NUM_FIELDS + field`. */
+    std::vector<int64_t> instructions;
+    int64_t memoryReads = 0;    /**< Number of words read from memory, including output blocks. */
+    int64_t memoryWrites = 0;   /**< Number of words written to memory, including input blocks. */
+    int64_t jumpsTaken = 0;     /**< Number of jumps that have been taken. */
+    int64_t jumpsNotTaken = 0;  /**< Number of conditional jumps that have not been taken. */
+    int64_t overflows = 0;      /**< Number of times the overflow has been triggered. */
+    int64_t movedWords = 0;     /**< Number of words copied by MOVE. */
+    /** Unit time spent waiting for each device, including the polls of `JBUS` that jump and `JRED` that do not. */
+    std::vector<int64_t> deviceWaitCycles;
+    std::vector<int64_t> deviceInputWords;   /**< Words read from each device. */
+    std::vector<int64_t> deviceOutputWords;  /**< Words written to each device. */
+
+    /** Get the number of executed instructions with the operation and the field. */
+    [[nodiscard]] int64_t instructionCount(const int operation, const int field) const {
+        if (instructions.empty() || operation < 0 || operation >= NUM_OPERATIONS || field < 0 || field >= NUM_FIELDS) {
+            return 0;
+        }
+        return instructions[operation * NUM_FIELDS + field];
+    }
+};
+
+}  // namespace mixal
+
+
+#endif  // INCLUDE_COUNTERS_H_
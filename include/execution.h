@@ -0,0 +1,141 @@
+#ifndef INCLUDE_EXECUTION_H_
+#define INCLUDE_EXECUTION_H_
+
+#include <cstdint>
+#include <string>
+#include "memory.h"
+
+/**
+ * @file
+ * @brief Execution control: stop reasons, faults and breakpoint conditions.
+ */
+
+namespace mixal {
+
+/** The reason why a run of the machine has been stopped. */
+enum class StopReason {
+    HALT,                  /**< The HLT operation has been met. */
+    SELF_LOOP,             /**< An instruction jumps to itself. */
+    BREAKPOINT,            /**< The next instruction is at a breakpoint. */
+    WATCH_READ,            /**< The last instruction read a watched memory location. */
+    WATCH_WRITE,           /**< The last instruction wrote a watched memory location. */
+    ERROR,                 /**< A runtime error has been encountered. */
+    BUDGET_EXHAUSTED,      /**< The limit of steps or unit time has been reached. */
+    WAITING_FOR_INPUT,     /**< The next instruction reads from an input device that has no more data. */
+    RESOURCE_LIMIT,        /**< The next instruction would exceed a resource limit. */
+    NON_TERMINATING_LOOP,  /**< The machine has returned to an identical state. */
+};
+
+/** The kind of resource that has been exhausted. */
+enum class ResourceKind {
+    NONE,
+    PRINTED_LINES,  /**< Lines written to the line printer. */
+    PUNCHED_CARDS,  /**< Cards written to the card punch. */
+    TAPE_BLOCKS,    /**< Blocks written to magnetic tapes. */
+    DISK_BLOCKS,    /**< Blocks written to disks or drums. */
+    MOVED_WORDS,    /**< Words copied by the MOVE operation. */
+    ELAPSED,        /**< Simulated unit time. */
+    WALL_CLOCK,     /**< Real time of the host. */
+};
+
+/** The kind of error raised by an instruction. */
+enum class FaultCode {
+    NONE,
+    INVALID_LINE,            /**< The location of the next instruction is outside the memory. */
+    INVALID_INDEX,           /**< The index of the instruction is not an index register. */
+    INVALID_ADDRESS,         /**< The indexed address is outside the memory. */
+    INVALID_FIELD,           /**< The field is not a valid partial field. */
+    DIVISION_BY_ZERO,        /**< DIV with a zero divisor. */
+    FLOAT_DIVISION_BY_ZERO,  /**< FDIV with a zero divisor. */
+    INT_OUTSIDE_HANDLER,     /**< INT without an interrupt being handled. */
+    READ_NOT_SUPPORTED,      /**< IN from a device that cannot be read. */
+    WRITE_NOT_SUPPORTED,     /**< OUT to a device that cannot be written. */
+    BLOCK_OUT_OF_MEMORY,     /**< The block of IN or OUT exceeds the memory. */
+    RESOURCE_LIMIT,          /**< The instruction would exceed a resource limit outside `run()`. */
+    INVALID_DEVICE,          /**< The field of an IO instruction is not a device. */
+    NULL_DEVICE,             /**< The factory of a user-defined device returns null. */
+};
+
+/** The error raised by an instruction, the message is only built when it is reported. */
+struct Fault {
+    FaultCode code = FaultCode::NONE;
+    int32_t line = 0;          /**< The location of the instruction. */
+    ComputerWord instruction;  /**< The faulting instruction. */
+    /** The invalid value: the line, the index, the address, the field, the device or the `ResourceKind`. */
+    int32_t operand = 0;
+    int32_t blockSize = 0;     /**< The size of the block when the code is `BLOCK_OUT_OF_MEMORY`. */
+
+    /** The same message as the `RuntimeError` thrown for the fault. */
+    [[nodiscard]] std::string message() const;
+};
+
+/** The result of a run of the machine. */
+struct StopInfo {
+    StopReason reason;    /**< Why the machine has been stopped. */
+    int32_t line;         /**< The location of the instruction that caused the stop. */
+    int32_t address;      /**< The watched memory location, or -1 if not triggered by a watchpoint. */
+    std::string message;  /**< The error information when the reason is `ERROR`. */
+    ResourceKind resource = ResourceKind::NONE;  /**< The exceeded resource when the reason is `RESOURCE_LIMIT`. */
+    Fault fault = Fault();  /**< The fault when the `ERROR` has been raised by an instruction, `NONE` otherwise. */
+};
+
+/** Limits of resources for running untrusted codes. Negative values mean unlimited. */
+struct ResourceLimits {
+    int64_t printedLines = -1;
+    int64_t punchedCards = -1;
+    int64_t tapeBlocks = -1;
+    int64_t diskBlocks = -1;
+    int64_t movedWords = -1;
+    int64_t elapsed = -1;
+    int64_t wallClockMilliseconds = -1;  /**< The deadline is counted from when the limits are set. */
+    int64_t wallClockCheckInterval = 1024;  /**< The number of steps between two checks of the wall clock. */
+};
+
+/** Resources consumed by the machine since the last reset. */
+struct ResourceUsage {
+    int64_t printedLines = 0;
+    int64_t punchedCards = 0;
+    int64_t tapeBlocks = 0;
+    int64_t diskBlocks = 0;
+    int64_t movedWords = 0;
+};
+
+/** Registers that can be tested in a conditional breakpoint. */
+enum class RegisterName {
+    A, X, I1, I2, I3, I4, I5, I6, J,
+};
+
+/** Comparison operators used in a conditional breakpoint. */
+enum class ConditionOperator {
+    EQUAL,
+    NOT_EQUAL,
+    LESS,
+    LESS_EQUAL,
+    GREATER,
+    GREATER_EQUAL,
+};
+
+/** A breakpoint only triggers when the value of the register satisfies the condition. */
+struct BreakpointCondition {
+    RegisterName reg;
+    ConditionOperator op;
+    WordValue value;
+
+    /** Whether the given register value satisfies the condition. */
+    [[nodiscard]] bool check(const WordValue actual) const {
+        switch (op) {
+        case ConditionOperator::EQUAL: return actual == value;
+        case ConditionOperator::NOT_EQUAL: return actual != value;
+        case ConditionOperator::LESS: return actual < value;
+        case ConditionOperator::LESS_EQUAL: return actual <= value;
+        case ConditionOperator::GREATER: return actual > value;
+        case ConditionOperator::GREATER_EQUAL: return actual >= value;
+        }
+        return false;
+    }
+};
+
+}  // namespace mixal
+
+
+#endif  // INCLUDE_EXECUTION_H_
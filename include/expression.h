@@ -6,6 +6,7 @@
 #include <unordered_map>
 #include <unordered_set>
 #include "errors.h"
+#include "memory.h"
 
 /**
  * @file
@@ -25,13 +26,13 @@ enum class AtomicType {
 struct Atomic {
     AtomicType type;     /**< The type of the atomic. */
     bool negative;       /**< The sign for the integer value. */
-    int32_t integer;     /**< The absolute value part of the integer. */
+    WordValue integer;   /**< The absolute value part of the integer. */
     std::string symbol;  /**< The named symbol for the symbol and the current location. */
 
     /** Initialize the atomic with specific atomic type. */
     explicit Atomic(AtomicType _type = AtomicType::INTEGER, bool _negative = false);
     /** Initialize the atomic with an integer value. */
-    Atomic(AtomicType _type, int32_t _value, bool _negative = false);
+    Atomic(AtomicType _type, WordValue _value, bool _negative = false);
     /** Initialize the atomic with a symbol. */
     Atomic(AtomicType _type, const std::string& _value, bool _negative = false);
 
@@ -72,12 +73,12 @@ struct Atomic {
  */
 struct AtomicValue {
     bool negative;
-    int32_t value;
+    WordValue value;
 
     /** Initialize with `+0`. */
     AtomicValue();
     /** Initialize with an integer value. */
-    explicit AtomicValue(int32_t _value);
+    explicit AtomicValue(WordValue _value);
     /** Initialize with another atomic value. */
     AtomicValue(const AtomicValue& atomicValue);
     /** The copy assign operation. */
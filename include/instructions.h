@@ -1,8 +1,12 @@
 #ifndef INCLUDE_INSTRUCTIONS_H_
 #define INCLUDE_INSTRUCTIONS_H_
 
+#include <array>
 #include <cstdint>
+#include <limits>
 #include <string>
+#include <string_view>
+#include "memory.h"
 
 /**
  * @file
@@ -28,6 +32,7 @@ class Instructions {
         NUM = 5,    // convert to numeric (0)
         CHAR = 5,   // convert to characters (1)
         HLT = 5,    // halt (2)
+        INT = 5,    // interrupt return (9)
         SLA = 6,    // shift left A (0)
         SRA = 6,    // shift right A (1)
         SLAX = 6,   // shift left AX (2)
@@ -174,8 +179,22 @@ class Instructions {
         END = 104,   // pseudo-operation: end
     };
 
+    /** The number of operation codes. */
+    static constexpr int NUM_CODES = LAST + 1;
+
+    /** The properties of an operation name. */
+    struct Operation {
+        std::string_view mnemonic;  /**< The upper-case name. */
+        Code code;                  /**< The operation or pseudo-operation. */
+        int8_t defaultField;        /**< The field implied by the name, -1 if any field can be given. */
+        uint8_t cost;               /**< The unit time. */
+        bool costPerWord;           /**< Whether each word of the field costs 2 more units, which is MOVE. */
+    };
+
     /** Whether the operation has extra arguments. */
     static bool hasArguments(Code code);
+    /** Find the operation of the name ignoring the case, null if the name is unknown. */
+    static const Operation* findOperation(std::string_view name);
     /** The type from the name of the operation. */
     static Code getInstructionCode(const std::string& name);
     /** Get default field value from the operation name. */
@@ -184,6 +203,199 @@ class Instructions {
     static int getCost(Code code, uint8_t field = 0);
 };
 
+/** All the names of the operations and the pseudo-operations, ordered by their codes.
+ *
+ * The first name of an operation gives the cost of the fields that have no names of their own.
+ */
+inline constexpr Instructions::Operation OPERATIONS[] = {
+    {"NOP",  Instructions::NOP,  -1, 1,  false},
+    {"ADD",  Instructions::ADD,  -1, 2,  false},
+    {"FADD", Instructions::ADD,   6, 2,  false},
+    {"SUB",  Instructions::SUB,  -1, 2,  false},
+    {"FSUB", Instructions::SUB,   6, 2,  false},
+    {"MUL",  Instructions::MUL,  -1, 10, false},
+    {"FMUL", Instructions::MUL,   6, 10, false},
+    {"DIV",  Instructions::DIV,  -1, 12, false},
+    {"FDIV", Instructions::DIV,   6, 12, false},
+    {"NUM",  Instructions::NUM,   0, 10, false},
+    {"CHAR", Instructions::NUM,   1, 10, false},
+    {"HLT",  Instructions::NUM,   2, 10, false},
+    {"FLOT", Instructions::NUM,   6, 10, false},
+    {"FIX",  Instructions::NUM,   7, 10, false},
+    {"INT",  Instructions::NUM,   9, 2,  false},
+    {"SLA",  Instructions::SLA,   0, 2,  false},
+    {"SRA",  Instructions::SLA,   1, 2,  false},
+    {"SLAX", Instructions::SLA,   2, 2,  false},
+    {"SRAX", Instructions::SLA,   3, 2,  false},
+    {"SLC",  Instructions::SLA,   4, 2,  false},
+    {"SRC",  Instructions::SLA,   5, 2,  false},
+    {"MOVE", Instructions::MOVE, -1, 1,  true},
+    {"LDA",  Instructions::LDA,  -1, 2,  false},
+    {"LD1",  Instructions::LD1,  -1, 2,  false},
+    {"LD2",  Instructions::LD2,  -1, 2,  false},
+    {"LD3",  Instructions::LD3,  -1, 2,  false},
+    {"LD4",  Instructions::LD4,  -1, 2,  false},
+    {"LD5",  Instructions::LD5,  -1, 2,  false},
+    {"LD6",  Instructions::LD6,  -1, 2,  false},
+    {"LDX",  Instructions::LDX,  -1, 2,  false},
+    {"LDAN", Instructions::LDAN, -1, 2,  false},
+    {"LD1N", Instructions::LD1N, -1, 2,  false},
+    {"LD2N", Instructions::LD2N, -1, 2,  false},
+    {"LD3N", Instructions::LD3N, -1, 2,  false},
+    {"LD4N", Instructions::LD4N, -1, 2,  false},
+    {"LD5N", Instructions::LD5N, -1, 2,  false},
+    {"LD6N", Instructions::LD6N, -1, 2,  false},
+    {"LDXN", Instructions::LDXN, -1, 2,  false},
+    {"STA",  Instructions::STA,  -1, 2,  false},
+    {"ST1",  Instructions::ST1,  -1, 2,  false},
+    {"ST2",  Instructions::ST2,  -1, 2,  false},
+    {"ST3",  Instructions::ST3,  -1, 2,  false},
+    {"ST4",  Instructions::ST4,  -1, 2,  false},
+    {"ST5",  Instructions::ST5,  -1, 2,  false},
+    {"ST6",  Instructions::ST6,  -1, 2,  false},
+    {"STX",  Instructions::STX,  -1, 2,  false},
+    {"STJ",  Instructions::STJ,   2, 2,  false},
+    {"STZ",  Instructions::STZ,  -1, 2,  false},
+    {"JBUS", Instructions::JBUS, -1, 1,  false},
+    {"IOC",  Instructions::IOC,  -1, 1,  false},
+    {"IN",   Instructions::IN,   -1, 1,  false},
+    {"OUT",  Instructions::OUT,  -1, 1,  false},
+    {"JRED", Instructions::JRED, -1, 1,  false},
+    {"JMP",  Instructions::JMP,   0, 1,  false},
+    {"JSJ",  Instructions::JMP,   1, 1,  false},
+    {"JOV",  Instructions::JMP,   2, 1,  false},
+    {"JNOV", Instructions::JMP,   3, 1,  false},
+    {"JL",   Instructions::JMP,   4, 1,  false},
+    {"JE",   Instructions::JMP,   5, 1,  false},
+    {"JG",   Instructions::JMP,   6, 1,  false},
+    {"JGE",  Instructions::JMP,   7, 1,  false},
+    {"JNE",  Instructions::JMP,   8, 1,  false},
+    {"JLE",  Instructions::JMP,   9, 1,  false},
+    {"JAN",  Instructions::JAN,   0, 1,  false},
+    {"JAZ",  Instructions::JAN,   1, 1,  false},
+    {"JAP",  Instructions::JAN,   2, 1,  false},
+    {"JANN", Instructions::JAN,   3, 1,  false},
+    {"JANZ", Instructions::JAN,   4, 1,  false},
+    {"JANP", Instructions::JAN,   5, 1,  false},
+    {"J1N",  Instructions::J1N,   0, 1,  false},
+    {"J1Z",  Instructions::J1N,   1, 1,  false},
+    {"J1P",  Instructions::J1N,   2, 1,  false},
+    {"J1NN", Instructions::J1N,   3, 1,  false},
+    {"J1NZ", Instructions::J1N,   4, 1,  false},
+    {"J1NP", Instructions::J1N,   5, 1,  false},
+    {"J2N",  Instructions::J2N,   0, 1,  false},
+    {"J2Z",  Instructions::J2N,   1, 1,  false},
+    {"J2P",  Instructions::J2N,   2, 1,  false},
+    {"J2NN", Instructions::J2N,   3, 1,  false},
+    {"J2NZ", Instructions::J2N,   4, 1,  false},
+    {"J2NP", Instructions::J2N,   5, 1,  false},
+    {"J3N",  Instructions::J3N,   0, 1,  false},
+    {"J3Z",  Instructions::J3N,   1, 1,  false},
+    {"J3P",  Instructions::J3N,   2, 1,  false},
+    {"J3NN", Instructions::J3N,   3, 1,  false},
+    {"J3NZ", Instructions::J3N,   4, 1,  false},
+    {"J3NP", Instructions::J3N,   5, 1,  false},
+    {"J4N",  Instructions::J4N,   0, 1,  false},
+    {"J4Z",  Instructions::J4N,   1, 1,  false},
+    {"J4P",  Instructions::J4N,   2, 1,  false},
+    {"J4NN", Instructions::J4N,   3, 1,  false},
+    {"J4NZ", Instructions::J4N,   4, 1,  false},
+    {"J4NP", Instructions::J4N,   5, 1,  false},
+    {"J5N",  Instructions::J5N,   0, 1,  false},
+    {"J5Z",  Instructions::J5N,   1, 1,  false},
+    {"J5P",  Instructions::J5N,   2, 1,  false},
+    {"J5NN", Instructions::J5N,   3, 1,  false},
+    {"J5NZ", Instructions::J5N,   4, 1,  false},
+    {"J5NP", Instructions::J5N,   5, 1,  false},
+    {"J6N",  Instructions::J6N,   0, 1,  false},
+    {"J6Z",  Instructions::J6N,   1, 1,  false},
+    {"J6P",  Instructions::J6N,   2, 1,  false},
+    {"J6NN", Instructions::J6N,   3, 1,  false},
+    {"J6NZ", Instructions::J6N,   4, 1,  false},
+    {"J6NP", Instructions::J6N,   5, 1,  false},
+    {"JXN",  Instructions::JXN,   0, 1,  false},
+    {"JXZ",  Instructions::JXN,   1, 1,  false},
+    {"JXP",  Instructions::JXN,   2, 1,  false},
+    {"JXNN", Instructions::JXN,   3, 1,  false},
+    {"JXNZ", Instructions::JXN,   4, 1,  false},
+    {"JXNP", Instructions::JXN,   5, 1,  false},
+    {"INCA", Instructions::INCA,  0, 1,  false},
+    {"DECA", Instructions::INCA,  1, 1,  false},
+    {"ENTA", Instructions::INCA,  2, 1,  false},
+    {"ENNA", Instructions::INCA,  3, 1,  false},
+    {"INC1", Instructions::INC1,  0, 1,  false},
+    {"DEC1", Instructions::INC1,  1, 1,  false},
+    {"ENT1", Instructions::INC1,  2, 1,  false},
+    {"ENN1", Instructions::INC1,  3, 1,  false},
+    {"INC2", Instructions::INC2,  0, 1,  false},
+    {"DEC2", Instructions::INC2,  1, 1,  false},
+    {"ENT2", Instructions::INC2,  2, 1,  false},
+    {"ENN2", Instructions::INC2,  3, 1,  false},
+    {"INC3", Instructions::INC3,  0, 1,  false},
+    {"DEC3", Instructions::INC3,  1, 1,  false},
+    {"ENT3", Instructions::INC3,  2, 1,  false},
+    {"ENN3", Instructions::INC3,  3, 1,  false},
+    {"INC4", Instructions::INC4,  0, 1,  false},
+    {"DEC4", Instructions::INC4,  1, 1,  false},
+    {"ENT4", Instructions::INC4,  2, 1,  false},
+    {"ENN4", Instructions::INC4,  3, 1,  false},
+    {"INC5", Instructions::INC5,  0, 1,  false},
+    {"DEC5", Instructions::INC5,  1, 1,  false},
+    {"ENT5", Instructions::INC5,  2, 1,  false},
+    {"ENN5", Instructions::INC5,  3, 1,  false},
+    {"INC6", Instructions::INC6,  0, 1,  false},
+    {"DEC6", Instructions::INC6,  1, 1,  false},
+    {"ENT6", Instructions::INC6,  2, 1,  false},
+    {"ENN6", Instructions::INC6,  3, 1,  false},
+    {"INCX", Instructions::INCX,  0, 1,  false},
+    {"DECX", Instructions::INCX,  1, 1,  false},
+    {"ENTX", Instructions::INCX,  2, 1,  false},
+    {"ENNX", Instructions::INCX,  3, 1,  false},
+    {"CMPA", Instructions::CMPA, -1, 2,  false},
+    {"FCMP", Instructions::CMPA,  6, 2,  false},
+    {"CMP1", Instructions::CMP1, -1, 2,  false},
+    {"CMP2", Instructions::CMP2, -1, 2,  false},
+    {"CMP3", Instructions::CMP3, -1, 2,  false},
+    {"CMP4", Instructions::CMP4, -1, 2,  false},
+    {"CMP5", Instructions::CMP5, -1, 2,  false},
+    {"CMP6", Instructions::CMP6, -1, 2,  false},
+    {"CMPX", Instructions::CMPX, -1, 2,  false},
+    {"EQU",  Instructions::EQU,  -1, 0,  false},
+    {"ORIG", Instructions::ORIG, -1, 0,  false},
+    {"CON",  Instructions::CON,  -1, 0,  false},
+    {"ALF",  Instructions::ALF,  -1, 0,  false},
+    {"END",  Instructions::END,  -1, 0,  false},
+};
+
+/** The unit time of each operation and field, indexed by `code * BYTE_SIZE + field`. */
+inline constexpr auto OPERATION_COSTS = [] {
+    static_assert(1 + 2 * (BYTE_SIZE - 1) <= std::numeric_limits<uint8_t>::max());
+    std::array<uint8_t, Instructions::NUM_CODES * BYTE_SIZE> costs{};
+    std::array<bool, Instructions::NUM_CODES> named{};
+    for (const auto& operation : OPERATIONS) {
+        const int code = operation.code;
+        if (code > Instructions::LAST) {
+            continue;
+        }
+        if (!named[code]) {
+            named[code] = true;
+            for (int field = 0; field < BYTE_SIZE; ++field) {
+                costs[code * BYTE_SIZE + field] = static_cast<uint8_t>(operation.cost + (operation.costPerWord ? 2 * field : 0));
+            }
+        } else if (operation.defaultField >= 0) {
+            costs[code * BYTE_SIZE + operation.defaultField] = operation.cost;
+        }
+    }
+    return costs;
+}();
+
+inline int Instructions::getCost(const Code code, const uint8_t field) {
+    if (static_cast<unsigned>(code) >= static_cast<unsigned>(NUM_CODES) || field >= BYTE_SIZE) {
+        return 0;
+    }
+    return OPERATION_COSTS[code * BYTE_SIZE + field];
+}
+
 }  // namespace mixal
 
 
@@ -1,7 +1,20 @@
 #ifndef INCLUDE_IO_H_
 #define INCLUDE_IO_H_
 
+#include <array>
+#include <bit>
+#include <condition_variable>
 #include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <istream>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <span>
+#include <thread>
 #include <vector>
 #include <string>
 #include "memory.h"
@@ -22,6 +35,7 @@ enum class IODeviceType {
     LINE_PRINTER,  // 24 words
     TYPEWRITER,    // 14 words
     PAPER_TAPE,    // 14 words
+    CUSTOM,        // user-defined
 };
 
 /** Status of an IO device. */
@@ -31,6 +45,247 @@ enum class IODeviceStatus {
     BUSY_WRITE,  /**< The device is writing. */
 };
 
+/** Sparse storage of a device.
+ *
+ * The words are grouped into fixed size pages, a page is only allocated when one of its words is modified.
+ * Unallocated words are read as zeros, and the storage grows when a word beyond its size is modified.
+ */
+class PagedStorage {
+ public:
+    static constexpr int32_t PAGE_SIZE = 256;  /**< Number of words in one page. */
+
+    /** Initialize an empty storage with the given number of words. */
+    explicit PagedStorage(int32_t size = 0);
+    PagedStorage(const PagedStorage& other);
+    PagedStorage& operator=(const PagedStorage& other);
+    PagedStorage(PagedStorage&&) noexcept = default;
+    PagedStorage& operator=(PagedStorage&&) noexcept = default;
+
+    /** The number of words in the storage. */
+    [[nodiscard]] int32_t size() const { return _size; }
+    /** The number of pages that have been allocated. */
+    [[nodiscard]] int32_t numAllocatedPages() const;
+    /** Get a word without allocating its page. */
+    [[nodiscard]] const ComputerWord& get(int32_t index) const;
+    /** Get a word for modification, the page is allocated if necessary.
+     *
+     * @throw std::out_of_range When the index is negative.
+     */
+    ComputerWord& at(int32_t index);
+    /** Copy consecutive words page by page, the unallocated ones are read as zeros. */
+    void load(int32_t index, ComputerWord* words, int32_t count) const;
+    /** Copy consecutive words page by page, allocating the pages if necessary.
+     *
+     * @throw std::out_of_range When the index is negative.
+     */
+    void store(int32_t index, const ComputerWord* words, int32_t count);
+    /** Release all the pages and restore the size. */
+    void clear(int32_t size);
+
+ private:
+    using Page = std::array<ComputerWord, PAGE_SIZE>;
+
+    int32_t _size;  /**< The number of words in the storage. */
+    std::vector<std::unique_ptr<Page>> _pages;  /**< Allocated pages, null if not touched. */
+};
+
+/** Words stored in a memory-mapped file.
+ *
+ * Each word is encoded in `WORD_BYTES` little-endian bytes: the five bytes of `BYTE_BITS` bits occupy the lowest bits
+ * with `byte5` the lowest, and the next bit is the sign. With binary bytes, this is 6-bit bytes in bits 0-29,
+ * the sign in bit 30 and 4 bytes per word. The words beyond the end of the file are read as zeros,
+ * the file grows when one of them is written. The data is shared with the file, so it persists across runs.
+ * The file is extended ahead of the writes, and it is truncated to the written words when it is closed.
+ */
+class MappedStorage {
+ public:
+    static constexpr int BYTE_BITS = std::bit_width(static_cast<uint32_t>(BYTE_SIZE - 1));  /**< Bits of a byte. */
+    static constexpr int32_t WORD_BYTES = (5 * BYTE_BITS + 1 + 7) / 8;  /**< Number of bytes of an encoded word. */
+
+    /** Map the file, it is created if it does not exist.
+     *
+     * @throw std::runtime_error When the file cannot be opened or mapped.
+     */
+    explicit MappedStorage(const std::string& path);
+    ~MappedStorage();
+    MappedStorage(const MappedStorage&) = delete;
+    MappedStorage& operator=(const MappedStorage&) = delete;
+
+    /** The path of the mapped file. */
+    [[nodiscard]] const std::string& path() const { return _path; }
+    /** The number of words in the file, excluding the space reserved for later writes. */
+    [[nodiscard]] int32_t size() const { return _size; }
+    /** Decode a word. */
+    [[nodiscard]] ComputerWord get(int32_t index) const;
+    /** Encode a word, the file is extended if necessary. */
+    void set(int32_t index, const ComputerWord& word);
+    /** Decode consecutive words, the following words are read ahead by the host. */
+    void load(int32_t index, ComputerWord* words, int32_t count);
+    /** Encode consecutive words, the file is extended if necessary. */
+    void store(int32_t index, const ComputerWord* words, int32_t count);
+    /** Write the modified pages back to the file. */
+    void flush();
+
+    /** Encode a word in the compact format. */
+    static uint64_t encode(const ComputerWord& word);
+    /** Decode a word from the compact format. */
+    static ComputerWord decode(uint64_t code);
+
+ private:
+    std::string _path;  /**< The path of the mapped file. */
+    int _fd;            /**< The file descriptor. */
+    uint8_t* _data;     /**< The mapped region, null when the file is empty. */
+    int32_t _size;      /**< The number of words that have been in the file or written, at most the capacity. */
+    int32_t _capacity;  /**< The number of words in the mapped region. */
+    int32_t _prefetched;  /**< The end of the words that the host has been asked to read ahead. */
+
+    /** Ask the host to read the words after the accessed ones in the background. */
+    void prefetch(int32_t index, int32_t count);
+
+    /** Extend the file and remap it to hold at least the given number of words. */
+    void grow(int32_t size);
+    /** Map the given number of words of the file, nothing is mapped if it fails. */
+    bool map(int32_t capacity);
+    /** Unmap the region. */
+    void unmap();
+};
+
+/** Source of the blocks consumed by a sequential input device. */
+class BlockSource {
+ public:
+    virtual ~BlockSource() = default;
+    /** Fill the next block, return false if there is no more block. */
+    virtual bool next(ComputerWord* words, int32_t count) = 0;
+};
+
+/** Sink of the blocks produced by a sequential output device. */
+class BlockSink {
+ public:
+    virtual ~BlockSink() = default;
+    /** Receive a block once its writing has been finished. */
+    virtual void put(const ComputerWord* words, int32_t count) = 0;
+    /** Wait until the received blocks have been written by the host. */
+    virtual void flush() {}
+};
+
+/** Source that converts one line of text to one block.
+ *
+ * The line is padded with spaces or truncated to fit the block,
+ * characters that are not in the character set of MIX become spaces.
+ */
+class TextBlockSource final : public BlockSource {
+ public:
+    /** Read lines from a stream, the stream should outlive the source. */
+    explicit TextBlockSource(std::istream& in);
+    /** Read lines from a stream owned by the source, e.g. a file or a string stream. */
+    explicit TextBlockSource(std::unique_ptr<std::istream> in);
+    /** Read lines from a callback, it returns false when there is no more line. */
+    explicit TextBlockSource(std::function<bool(std::string&)> nextLine);
+
+    bool next(ComputerWord* words, int32_t count) override;
+
+    /** Convert text to consecutive words. */
+    static void convert(const std::string& text, ComputerWord* words, int32_t count);
+
+ private:
+    std::unique_ptr<std::istream> _owned;  /**< The owned stream. */
+    std::function<bool(std::string&)> _nextLine;
+};
+
+/** Sink that converts each block to one line of text without trailing spaces. */
+class TextBlockSink final : public BlockSink {
+ public:
+    /** Write lines to a stream, the stream should outlive the sink. */
+    explicit TextBlockSink(std::ostream& out);
+    /** Write lines to a stream owned by the sink, e.g. a file. */
+    explicit TextBlockSink(std::unique_ptr<std::ostream> out);
+    /** Pass the lines to a callback. */
+    explicit TextBlockSink(std::function<void(const std::string&)> putLine);
+
+    void put(const ComputerWord* words, int32_t count) override;
+    void flush() override;
+
+    /** Convert consecutive words to text. */
+    static std::string convert(const ComputerWord* words, int32_t count);
+
+ private:
+    std::unique_ptr<std::ostream> _owned;  /**< The owned stream. */
+    std::ostream* _stream;                 /**< The stream to flush, null if the lines are passed to a callback. */
+    std::function<void(const std::string&)> _putLine;
+};
+
+/** Source that fetches the blocks of another source on a background thread.
+ *
+ * The blocks are fetched ahead in order, so the machine consumes exactly the same data,
+ * only the host reading overlaps with the execution.
+ * The inner source is only called from the background thread, so it should not rely on the calling thread.
+ */
+class AsyncBlockSource final : public BlockSource {
+ public:
+    static constexpr int32_t DEFAULT_DEPTH = 64;  /**< Default number of blocks fetched ahead. */
+
+    explicit AsyncBlockSource(std::shared_ptr<BlockSource> source, int32_t depth = DEFAULT_DEPTH);
+    ~AsyncBlockSource() override;
+    AsyncBlockSource(const AsyncBlockSource&) = delete;
+    AsyncBlockSource& operator=(const AsyncBlockSource&) = delete;
+
+    /** Take the next block, wait for the background thread if it has not been fetched.
+     *
+     * The background thread starts at the first call, all the calls should use the same count.
+     *
+     * @throw std::logic_error When the count is different from the first call.
+     */
+    bool next(ComputerWord* words, int32_t count) override;
+
+ private:
+    std::shared_ptr<BlockSource> _source;
+    int32_t _depth;      /**< Maximum number of blocks fetched ahead. */
+    int32_t _blockSize;  /**< The count of the first call. */
+    std::deque<std::vector<ComputerWord>> _blocks;  /**< Fetched blocks. */
+    bool _finished;      /**< Whether the inner source has ended. */
+    bool _stopping;      /**< Whether the background thread should exit. */
+    std::exception_ptr _error;  /**< The error raised by the inner source. */
+    std::mutex _mutex;
+    std::condition_variable _fetched, _consumed;
+    std::thread _worker;
+
+    void work();
+};
+
+/** Sink that passes the blocks to another sink on a background thread.
+ *
+ * The blocks are passed in the order they are written, and all of them have been passed
+ * once `flush()` returns or the sink is destroyed.
+ */
+class AsyncBlockSink final : public BlockSink {
+ public:
+    explicit AsyncBlockSink(std::shared_ptr<BlockSink> sink);
+    ~AsyncBlockSink() override;
+    AsyncBlockSink(const AsyncBlockSink&) = delete;
+    AsyncBlockSink& operator=(const AsyncBlockSink&) = delete;
+
+    /** Queue a copy of the block.
+     *
+     * @throw std::exception The error raised by the inner sink for a previous block.
+     */
+    void put(const ComputerWord* words, int32_t count) override;
+    /** Wait until all the queued blocks have been passed to the inner sink and flushed. */
+    void flush() override;
+
+ private:
+    std::shared_ptr<BlockSink> _sink;
+    std::deque<std::vector<ComputerWord>> _blocks;  /**< Blocks that have not been passed. */
+    bool _busy;          /**< Whether the background thread is passing a block. */
+    bool _stopping;      /**< Whether the background thread should exit. */
+    std::exception_ptr _error;  /**< The error raised by the inner sink. */
+    std::mutex _mutex;
+    std::condition_variable _queued, _drained;
+    std::thread _worker;
+
+    void work();
+    void rethrow();
+};
+
 /** The IO device.
  * 
  * Once read or write, the device will not be ready immediately.
@@ -58,9 +313,24 @@ class IODevice {
     [[nodiscard]] bool allowWrite() const { return _allowWrite; }
 
     /** Whether the device is ready for reading or writing. */
-    virtual bool ready(int32_t timestamp);
+    virtual bool ready(int64_t timestamp);
+    /** Query the device at `timestamp`, `timestamp + interval`, ... until it is ready.
+     *
+     * @param limit No query is made at or after this time.
+     * @return The time of the query that finds the device ready, or the first time at or after `limit`.
+     */
+    virtual int64_t pollUntilReady(int64_t timestamp, int64_t interval,
+                                   int64_t limit = std::numeric_limits<int64_t>::max());
     /** Special control of the device. */
     virtual void control(int32_t) {}
+    /** Restore the initial state so that the device can be reused by another machine. */
+    virtual void reset();
+    /** Wait until the host has finished the writings that have been finished in the machine. */
+    virtual void flush() {}
+    /** Whether the next reading has no more data to consume. */
+    [[nodiscard]] virtual bool exhausted() const { return false; }
+    /** Whether there is a reading or writing that has not been finished. */
+    [[nodiscard]] virtual bool busy() const { return false; }
     /** Read one block from the device. */
     virtual void read(ComputerWord* memory, int32_t address) = 0;
     /** Write one block to the device. */
@@ -74,7 +344,7 @@ class IODevice {
     int32_t _blockSize;  /**< The number of bytes in one reading or writing. */
     bool _allowRead;     /**< Whether the device can be read. */
     bool _allowWrite;    /**< Whether the device can be wrote. */
-    int32_t _timestamp;  /**< The latest time that the device being triggered. */
+    int64_t _timestamp;  /**< The latest time that the device being triggered. */
     double _readyRate;   /**< The rate that the device could be ready in one unit time. */
 
     /** Perform the actual reading. */
@@ -90,17 +360,52 @@ class IODeviceStorage : public IODevice {
     IODeviceStorage(const IODeviceStorage&) = default;
     IODeviceStorage& operator=(const IODeviceStorage&) = default;
 
-    bool ready(int32_t elapsed) override;
+    bool ready(int64_t elapsed) override;
+    /** Sample the number of failed queries at once instead of querying one by one.
+     *
+     * A device without any unfinished operation is ready at once, so waiting on an idle device
+     * does not stall the machine.
+     */
+    int64_t pollUntilReady(int64_t timestamp, int64_t interval, int64_t limit) override;
+    void reset() override;
+    [[nodiscard]] bool busy() const override { return _status != IODeviceStatus::READY; }
     void read(ComputerWord* memory, int32_t address) override;
     void write(const ComputerWord* memory, int32_t address) override;
 
-    ComputerWord& wordAt(const int32_t index) override { return _storage[index]; }
+    /** Get a word from the storage.
+     *
+     * @throw std::logic_error When the storage is mapped to a file, use `loadWord` and `storeWord` instead.
+     */
+    ComputerWord& wordAt(int32_t index) override;
+    /** The storage of the device when it is not mapped to a file. */
+    [[nodiscard]] const PagedStorage& storage() const { return _storage; }
+
+    /** Map the storage to a file, the words in the memory storage are discarded.
+     *
+     * The mapping is released when the device is reset.
+     */
+    void mapFile(const std::string& path);
+    /** Flush and release the mapped file, the storage becomes empty. */
+    void unmapFile();
+    /** Whether the storage is mapped to a file. */
+    [[nodiscard]] bool mapped() const { return _mapped != nullptr; }
+    /** The number of words in the storage. */
+    [[nodiscard]] int32_t storageSize() const;
+    /** Get a word from the storage, whether it is mapped or not. */
+    [[nodiscard]] ComputerWord loadWord(int32_t index) const;
+    /** Set a word in the storage, whether it is mapped or not. */
+    void storeWord(int32_t index, const ComputerWord& word);
  protected:
     IODeviceStatus _status;
     int32_t _address, _locator;
+    int32_t _storageSize;  /**< The initial number of words in the storage. */
     ComputerWord* _memory;
-    std::vector<ComputerWord> _buffer;
-    std::vector<ComputerWord> _storage;
+    std::vector<ComputerWord> _buffer;  /**< Allocated at the first reading or writing. */
+    PagedStorage _storage;
+    std::shared_ptr<MappedStorage> _mapped;  /**< The mapped file, shared by the copies of the device. */
+
+    /** Perform the pending reading or writing. */
+    void finish();
 
     void doRead() override;
     void doWrite() override;
@@ -137,8 +442,21 @@ class IODeviceSeqReader : public IODeviceStorage {
  public:
     explicit IODeviceSeqReader(int32_t storageSize = 4096);
 
+    [[nodiscard]] bool exhausted() const override;
+    void reset() override;
+    void read(ComputerWord* memory, int32_t address) override;
+
+    /** Read the blocks from the source instead of the storage, null to restore the storage. */
+    void setSource(std::shared_ptr<BlockSource> source);
+
  private:
+    std::shared_ptr<BlockSource> _source;  /**< The source of blocks. */
+    std::vector<ComputerWord> _nextBlock;   /**< The block fetched ahead to know whether the source ends. */
+    bool _hasNextBlock;                     /**< Whether the fetched block is valid. */
+
     void doRead() override;
+    /** Fetch the next block from the source. */
+    void fetchNextBlock();
 };
 
 /** Write sequentially. */
@@ -146,7 +464,15 @@ class IODeviceSeqWriter : public IODeviceStorage {
  public:
     explicit IODeviceSeqWriter(int32_t storageSize = 4096);
 
+    void reset() override;
+    void flush() override;
+
+    /** Pass the blocks to the sink instead of the storage, null to restore the storage. */
+    void setSink(std::shared_ptr<BlockSink> sink);
+
  private:
+    std::shared_ptr<BlockSink> _sink;  /**< The sink of blocks. */
+
     void doWrite() override;
 };
 
@@ -173,6 +499,8 @@ class IODeviceLinePrinter final : public IODeviceSeqWriter {
     void control(int32_t operation) override;
     /** Get the printed line with the given page number and line number in the page. */
     [[nodiscard]] std::string line(int32_t pageNum, int32_t lineNum) const;
+    /** Get all the lines of a page separated by new lines, converted in one pass. */
+    [[nodiscard]] std::string page(int32_t pageNum) const;
 
     [[nodiscard]] int32_t numLinesPerPage() const { return _numLinesPerPage; }
  private:
@@ -193,6 +521,49 @@ class IODevicePaperTape final : public IODeviceSeqReader {
     void control(int32_t operation) override;
 };
 
+/** Creates the device of a unit after the machine has been reset. */
+using DeviceFactory = std::function<std::unique_ptr<IODevice>()>;
+
+/** User-defined device whose blocks are produced and consumed by callbacks.
+ *
+ * The callbacks receive a whole block at a time. The reading callback is called when the input is issued,
+ * and the block is copied to the memory when the device becomes ready,
+ * the writing callback is called with the block when the writing has been finished.
+ */
+class IODeviceCallback final : public IODeviceStorage {
+ public:
+    /** Fill the block, return false if there is no more data and the block should be zeros. */
+    using ReadCallback = std::function<bool(std::span<ComputerWord>)>;
+    /** Consume the written block. */
+    using WriteCallback = std::function<void(std::span<const ComputerWord>)>;
+    /** Receive the special control signal. */
+    using ControlCallback = std::function<void(int32_t)>;
+
+    /** Initialize the device, the device can not be read or written if the callback is null.
+     *
+     * @param blockSize The number of words in one reading or writing.
+     * @param onRead Called for each input.
+     * @param onWrite Called for each output.
+     * @param onControl Called for each IOC.
+     * @param readyRate The rate that the device could be ready in one unit time.
+     */
+    IODeviceCallback(int32_t blockSize, ReadCallback onRead, WriteCallback onWrite,
+                     ControlCallback onControl = nullptr, double readyRate = 1.0);
+
+    void control(int32_t operation) override;
+    [[nodiscard]] bool exhausted() const override { return _exhausted; }
+    void reset() override;
+    void read(ComputerWord* memory, int32_t address) override;
+
+ private:
+    ReadCallback _onRead;
+    WriteCallback _onWrite;
+    ControlCallback _onControl;
+    bool _exhausted;  /**< Whether the reading callback has reported the end of data. */
+
+    void doWrite() override;
+};
+
 }  // namespace mixal
 
 #endif  // INCLUDE_IO_H_
@@ -2,6 +2,10 @@
 #define INCLUDE_MACHINE_H_
 
 #include <map>
+#include <array>
+#include <bitset>
+#include <chrono>
+#include <limits>
 #include <vector>
 #include <string>
 #include <memory>
@@ -13,21 +17,33 @@
 #include "instructions.h"
 #include "io.h"
 #include "errors.h"
+#include "execution.h"
+#include "counters.h"
+#include "trace.h"
 
 /**
  * @file
  * @brief The virtual machine.
  */
 
+#ifndef MIXAL_MEMORY_SIZE
+#define MIXAL_MEMORY_SIZE 4000
+#endif
+
 namespace mixal {
 
 using InstructionWord = ComputerWord;
 
 class Computer {
+    friend struct TranslatedRuntime;
+
  public:
     static constexpr int NUM_INDEX_REGISTER = 6;  /**< Number of index registers. */
-    static constexpr int NUM_MEMORY = 4000;       /**< Number of words in memory. */
+    static constexpr int NUM_MEMORY = MIXAL_MEMORY_SIZE;  /**< Number of words in memory, set with `MIXAL_MEMORY_SIZE`. */
     static constexpr int NUM_IO_DEVICE = 21;      /**< Number of IO devices. */
+    static constexpr int INTERRUPT_SAVE_SIZE = 10;  /**< Number of words saved when an interrupt occurs. */
+
+    static_assert(0 < NUM_MEMORY && NUM_MEMORY <= WordFormat::power(2), "Every location must fit in an address");
 
     Register5 rA, /**< Accumulator register. */ rX;  /**< Extension register. */
     Register2 rI1 /**< Index register. */, rI2, rI3, rI4, rI5, rI6, rJ;  /**< Jump address register. */
@@ -59,6 +75,39 @@ class Computer {
     ComputerWord& memoryAt(int16_t index);
     /** Get the device based on the index value. */
     IODevice* getDevice(int32_t index);
+    /** Install a user-defined device for the unit, null to restore the built-in device.
+     *
+     * The current device of the unit is discarded. The factory is kept across resets,
+     * and it is called to create a new device whenever the unit is used after a reset.
+     *
+     * @throw mixal::RuntimeError When the unit is invalid.
+     */
+    void registerDevice(int32_t unit, DeviceFactory factory);
+    /** Whether a user-defined device has been registered for the unit. */
+    [[nodiscard]] bool hasRegisteredDevice(int32_t unit) const;
+    /** Back a tape (0-7) or a disk (8-15) with a memory-mapped file.
+     *
+     * The file is created if it does not exist, and it keeps the data after the machine is reset.
+     * The mapping is released by `reset()`, so it should be set after loading the codes.
+     *
+     * @throw mixal::RuntimeError When the device is neither a tape nor a disk.
+     * @throw std::runtime_error When the file cannot be mapped.
+     */
+    void mapDeviceFile(int32_t device, const std::string& path);
+    /** Flush and release the file of a tape or a disk. */
+    void unmapDeviceFile(int32_t device);
+    /** Read the blocks of a sequential input device (16 or 20) from a source, null to restore the storage.
+     *
+     * The source is released by `reset()`, so it should be set after loading the codes.
+     *
+     * @throw mixal::RuntimeError When the device is not a sequential input device.
+     */
+    void setDeviceSource(int32_t device, std::shared_ptr<BlockSource> source);
+    /** Pass the blocks of a sequential output device (17 or 18) to a sink, null to restore the storage.
+     *
+     * @throw mixal::RuntimeError When the device is not a sequential output device.
+     */
+    void setDeviceSink(int32_t device, std::shared_ptr<BlockSink> sink);
     /** Wait the IO device to be ready. */
     void waitDevice(IODevice* device);
     /** Wait all IO devices to be ready. */
@@ -71,7 +120,26 @@ class Computer {
     /** Get the current executing line of the memory. */
     [[nodiscard]] int line() const { return _lineOffset; }
     /** Get elapsed unit time after executing the codes. */
-    [[nodiscard]] int elapsed() const { return _elapsed; }
+    [[nodiscard]] int64_t elapsed() const { return _elapsed; }
+    /** Get the number of executed instructions. */
+    [[nodiscard]] int64_t steps() const { return _steps; }
+    /** Enable or disable the histogram of instructions, the counters are cleared. */
+    void setCountersEnabled(bool enabled);
+    /** Whether the histogram of instructions is being collected. */
+    [[nodiscard]] bool countersEnabled() const { return !_counters.instructions.empty(); }
+    /** Get a snapshot of all the performance counters. */
+    [[nodiscard]] PerformanceCounters performanceCounters() const;
+    /** Clear the performance counters. */
+    void resetPerformanceCounters();
+    /** Record the device events in a ring buffer of the given capacity, zero to stop the recording.
+     *
+     * The recorded events are removed. They are also removed when the machine is reset.
+     */
+    void setDeviceTraceCapacity(size_t capacity);
+    /** Get the recorded device events. */
+    [[nodiscard]] const DeviceTrace& deviceTrace() const { return _trace; }
+    /** Remove the recorded device events. */
+    void clearDeviceTrace();
 
     /** Get a unique symbol name. */
     std::string getSingleLineSymbol();
@@ -83,6 +151,18 @@ class Computer {
     void executeUntilHalt();
     /** Execute instructions until the HLT operation has been met or there is a self loop. */
     void executeUntilHaltOrSelfLoop();
+    /** Execute instructions until the machine stops or the budget is exhausted.
+     *
+     * The execution can be resumed by calling this function again.
+     * Breakpoints and watchpoints are respected, and the breakpoint at the current location is ignored.
+     * The errors raised by the instructions are reported in the result instead of being thrown,
+     * the exceptions thrown by the implementations of the devices are not caught.
+     *
+     * @param maxSteps The maximum number of instructions to execute, negative for unlimited.
+     * @param maxElapsed The maximum number of unit time to spend, negative for unlimited.
+     *                   The check happens between instructions, so the last one may exceed the limit.
+     */
+    StopInfo run(int64_t maxSteps = -1, int64_t maxElapsed = -1);
     /** Execute a single instruction based on the given instruction. */
     void executeSingle(ParsedResult* instruction);
     /** Execute a single instruction based on the given instruction. */
@@ -90,36 +170,254 @@ class Computer {
     /** Execute a single pseudo instruction. */
     void executeSinglePseudo(ParsedResult* instruction);
 
+    /** Stop before executing the instruction at the given location. */
+    void setBreakpoint(int32_t address);
+    /** Stop before executing the instruction at the given location if the condition holds. */
+    void setBreakpoint(int32_t address, const BreakpointCondition& condition);
+    /** Remove the breakpoint at the given location. */
+    void clearBreakpoint(int32_t address);
+    /** Remove all the breakpoints. */
+    void clearBreakpoints();
+    /** Whether there is a breakpoint at the given location. */
+    [[nodiscard]] bool hasBreakpoint(int32_t address) const;
+    /** Stop after an instruction reads or writes the given memory location. */
+    void setWatchpoint(int32_t address, bool onRead = false, bool onWrite = true);
+    /** Remove the watchpoint at the given memory location. */
+    void clearWatchpoint(int32_t address);
+    /** Remove all the watchpoints. */
+    void clearWatchpoints();
+    /** Execute instructions until a breakpoint, a watchpoint, a halt, a self loop or an error.
+     *
+     * @see run
+     */
+    StopInfo runUntilBreak();
+
+    /** Stop the runs when any of the resources would exceed the limits.
+     *
+     * `run()` reports the exceeded resource, the other execution loops throw a `RuntimeError`.
+     */
+    void setResourceLimits(const ResourceLimits& limits);
+    /** Remove all the resource limits. */
+    void clearResourceLimits();
+    /** Get the current resource limits. */
+    [[nodiscard]] const ResourceLimits& resourceLimits() const { return _limits; }
+    /** Get the resources consumed since the last reset. */
+    [[nodiscard]] const ResourceUsage& resourceUsage() const { return _usage; }
+
+    /** Whether to stop the runs when the machine state repeats, disabled by default.
+     *
+     * The state contains the registers, the flags, the memory and the location of the next instruction.
+     * It is sampled at backward jumps. Loops that use IO devices are never reported.
+     * Short cycles are found among the recent samples, and longer ones by comparing the samples
+     * with an anchor that is moved after 1, 2, 4, ... samples, so every cycle is eventually reported.
+     * `run()` stops with `NON_TERMINATING_LOOP`, `executeUntilSelfLoop()` and `executeUntilHaltOrSelfLoop()`
+     * return as they do for a self loop. The memory is hashed again whenever a run starts
+     * and the stores update the hash, so the runs are slower while it is enabled.
+     */
+    void setLoopDetection(const bool enabled) { _loopDetection = enabled; }
+    /** Whether to skip the idle iterations of `JBUS *(u)` and `JRED`/`JMP` polling loops at once.
+     *
+     * The elapsed time, the steps and the counters are advanced as if the iterations were executed,
+     * and the time of completion follows the same distribution. The skipped iterations stop at the budget
+     * of `run()` and at the elapsed limit as the executed ones would. It is ignored while any breakpoint is set.
+     */
+    void setIdleFastForward(const bool enabled) { _idleFastForward = enabled; }
+    /** Whether the idle polling loops are skipped. */
+    [[nodiscard]] bool idleFastForward() const { return _idleFastForward; }
+    /** Whether the detection of non-terminating loops is enabled. */
+    [[nodiscard]] bool loopDetection() const { return _loopDetection; }
+
+    /** Enable the interrupts of device completion at the given location, negative to disable them.
+     *
+     * When an IOC, IN or OUT issued with interrupts enabled has been finished, the machine saves
+     * rA, rX, rI1 to rI6 and rJ to `address` ... `address + 8` and a control word to `address + 9`:
+     * the location of the next instruction in the address field, the unit in the I field,
+     * the overflow toggle in byte 4, and the comparison indicator in byte 5 (0 less, 1 equal, 2 greater).
+     * It then enters the control state and continues from `address + 10`.
+     * The completions are checked between instructions, those met in the control state are delivered
+     * after `INT` has restored the saved state. The idle polling loops are not fast-forwarded.
+     *
+     * @throw mixal::RuntimeError When the saved area and the handler do not fit in the memory.
+     */
+    void setInterruptVector(int32_t address);
+    /** The location of the saved area, negative if interrupts are disabled. */
+    [[nodiscard]] int32_t interruptVector() const { return _interruptVector; }
+    /** Whether an interrupt is being handled. */
+    [[nodiscard]] bool inControlState() const { return _controlState; }
+
     /** Parse and load codes to memory. */
     void loadCodes(const std::string& codes, bool addHalt = true);
     /** Parse and load codes to memory. */
     void loadCodes(const std::vector<std::string>& codes, bool addHalt = true);
 
  private:
+    Register2 _noIndex;  /**< Always zero, selected by the index 0 of an instruction. */
+    /** The registers selected by the indices of instructions, a single load finds any of them. */
+    static constexpr Register2 Computer::* INDEX_REGISTERS[NUM_INDEX_REGISTER + 1] = {
+        &Computer::_noIndex, &Computer::rI1, &Computer::rI2, &Computer::rI3, &Computer::rI4, &Computer::rI5, &Computer::rI6,
+    };
+
     int32_t _pseudoVarIndex;  /**< Used to generate unique symbol name. */
     int32_t _lineOffset;      /**< The line of memory that is currently executing. */
-    int32_t _elapsed;         /**< The number of unit time that has been elapsed. */
+    int64_t _elapsed;         /**< The number of unit time that has been elapsed. */
+    int64_t _steps;           /**< The number of instructions that have been executed. */
+    int64_t _stepBudget;      /**< The steps at which the current run stops. */
+    int64_t _elapsedBudget;   /**< The elapsed time at which the current run stops. */
+    PerformanceCounters _counters;  /**< Counters updated during the execution. */
+    /** Number of executed instructions of each operation, the memory accesses and jumps are derived from it. */
+    std::array<int64_t, PerformanceCounters::NUM_OPERATIONS> _operationCounts;
+    DeviceTrace _trace;             /**< Device events, empty unless enabled. */
+    std::bitset<NUM_IO_DEVICE> _tracedBusy;  /**< Units with a traced operation that has not been completed. */
     /** The constants after executing the single line codes. */
     std::unordered_map<std::string, AtomicValue> _constants;
 
+    std::bitset<NUM_MEMORY> _breakpoints;       /**< Locations of breakpoints. */
+    std::bitset<NUM_MEMORY> _readWatchpoints;   /**< Memory locations watched for reading. */
+    std::bitset<NUM_MEMORY> _writeWatchpoints;  /**< Memory locations watched for writing. */
+    bool _hasBreakpoints;                       /**< Whether any breakpoint has been set. */
+    bool _hasWatchpoints;                       /**< Whether any watchpoint has been set. */
+    /** The conditions of conditional breakpoints. */
+    std::unordered_map<int32_t, BreakpointCondition> _breakpointConditions;
+
+    ResourceLimits _limits;  /**< Limits of resources. */
+    ResourceUsage _usage;    /**< Consumed resources. */
+    bool _hasLimits;         /**< Whether any resource limit has been set. */
+    std::chrono::steady_clock::time_point _deadline;  /**< The wall-clock deadline. */
+
+    static constexpr int NUM_LOOP_SETS = 64;  /**< Number of sets of recently sampled states. */
+    static constexpr int NUM_LOOP_WAYS = 4;   /**< Number of states kept in each set. */
+    bool _loopDetection;     /**< Whether to detect non-terminating loops. */
+    bool _idleFastForward;   /**< Whether to skip the idle iterations of polling loops. */
+    int32_t _interruptVector;  /**< The location of the saved area, negative if interrupts are disabled. */
+    bool _controlState;        /**< Whether an interrupt is being handled. */
+    std::bitset<NUM_IO_DEVICE> _interruptArmed;    /**< Units whose operations will cause interrupts. */
+    std::bitset<NUM_IO_DEVICE> _interruptPending;  /**< Units that have finished and wait to be handled. */
+    std::array<DeviceFactory, NUM_IO_DEVICE> _deviceFactories;  /**< Factories of user-defined devices. */
+    bool _memoryHashDirty;   /**< Whether the memory has been changed without updating the hash. */
+    uint64_t _memoryHash;    /**< The XOR of the hashes of all the memory words. */
+    /** Recently sampled state hashes, the newest first in each set, 0 means empty. */
+    std::array<uint64_t, NUM_LOOP_SETS * NUM_LOOP_WAYS> _loopStates;
+    uint64_t _loopAnchor;          /**< The sampled state compared with every later sample, 0 means empty. */
+    int64_t _loopAnchorPower;      /**< The number of samples before the anchor is moved. */
+    int64_t _loopAnchorDistance;   /**< The number of samples since the anchor has been moved. */
+    Fault _fault;  /**< The error raised by the current instruction, `NONE` if there is none. */
+
     /** Get a unique symbol name. */
     std::string getPseudoSymbolName();
+    /** Reset the devices and return them to the pool of the current thread. */
+    void releaseDevices();
+    /** Get the device of a valid unit, null if its factory returns null. */
+    IODevice* findDevice(int32_t index);
+    /** Get the device selected by the field of an IO instruction, raise a fault and return null if there is none. */
+    IODevice* instructionDevice(const InstructionWord& instruction);
+    /** Set the budget of the current run, the idle polling loops are not skipped past it. */
+    void setBudget(const int64_t stepLimit = std::numeric_limits<int64_t>::max(),
+                   const int64_t elapsedLimit = std::numeric_limits<int64_t>::max()) {
+        _stepBudget = stepLimit;
+        _elapsedBudget = elapsedLimit;
+    }
+    /** The number of polls, each taking `stepsPerPoll` instructions, that fit in the budget and the limits. */
+    [[nodiscard]] int64_t pollBudget(int64_t interval, int64_t stepsPerPoll) const;
+    /** Poll the device every interval until it is ready, at most `maxPolls` times.
+     *
+     * @return The number of failed polls. If all of them have failed, the elapsed time is the time of the last poll.
+     */
+    int64_t skipPolling(int32_t unit, IODevice* device, int64_t interval, int64_t maxPolls);
+    /** Record the start of an operation that has just been passed to the device. */
+    void traceStart(int32_t unit, Instructions::Code operation);
+    /** Record the completion if the traced operation of the unit has been finished. */
+    void traceCompletion(int32_t unit);
+    /** Record the error of the instruction, only the first one is kept until it is reported. */
+    void raiseFault(FaultCode code, const InstructionWord& instruction, int32_t operand = 0, int32_t blockSize = 0);
+    /** Whether an error has been raised and not reported. */
+    [[nodiscard]] bool faulted() const { return _fault.code != FaultCode::NONE; }
+    /** Clear the raised error and return it as the result of a run. */
+    StopInfo reportFault();
+    /** Clear the raised error and throw it. */
+    [[noreturn]] void throwFault();
+    /** Execute and retire the instruction, it is not retired if it raises an error. */
+    void executeInstruction(const InstructionWord& instruction);
+    /** Execute the instruction at the current location, or skip HLT and return true. The errors are raised. */
+    bool stepOrHalt();
+    /** Advance the location, the elapsed time and the counters after an instruction has been executed. */
+    void retire(const int operation, const int field, const int64_t cost) {
+        ++_lineOffset;
+        _elapsed += cost;
+        ++_steps;
+        ++_operationCounts[operation];
+        if (!_counters.instructions.empty()) {
+            ++_counters.instructions[operation * PerformanceCounters::NUM_FIELDS + field];
+        }
+        if (_interruptVector >= 0) {
+            checkInterrupts();
+        }
+    }
+    /** Check that a block of IO starting at the address fits in the memory. */
+    void checkBlockRange(const InstructionWord& instruction, int32_t address, int32_t blockSize);
+    /** Account the instruction as if it has been executed more times. */
+    void countSkipped(const InstructionWord& instruction, int64_t times);
+    /** Account the unit time of the polls that have found the device busy. */
+    void countPolling(const int32_t unit, const int64_t cycles) { _counters.deviceWaitCycles[unit] += cycles; }
+    /** Return from the interrupt handler. */
+    void executeINT();
+    /** Whether an interrupt may still arrive, so waiting in a loop is expected. */
+    [[nodiscard]] bool interruptExpected() const { return !_controlState && _interruptArmed.any(); }
+    /** Arm the interrupt of the unit if interrupts are enabled. */
+    void armInterrupt(int32_t unit);
+    /** Collect finished operations and enter the handler if possible. */
+    void checkInterrupts();
+    /** Save the state and jump to the handler. */
+    void enterInterrupt(int32_t unit);
 
     /** Get the address based on the base address and the index register. */
     int32_t getIndexedAddress(const InstructionWord& instruction, bool checkRange = false);
     /** Copy values considered the field value. */
-    void copyToRegister5(const InstructionWord& instruction, const ComputerWord& word, Register5* reg) const;
+    void copyToRegister5(const InstructionWord& instruction, const ComputerWord& word, Register5* reg);
     /** Copy values considered the field value. */
-    void copyFromRegister5(const InstructionWord& instruction, const Register5& reg, ComputerWord* word) const;
+    void copyFromRegister5(const InstructionWord& instruction, const Register5& reg, ComputerWord* word);
     /** Copy values considered the field value. */
-    void copyToRegister2(const InstructionWord& instruction, const ComputerWord& word, Register2* reg) const;
+    void copyToRegister2(const InstructionWord& instruction, const ComputerWord& word, Register2* reg);
+
+    WordValue checkRange(WordValue value, int bytes = 5);
+    /** Set the overflow flag and count the event. */
+    void triggerOverflow() {
+        overflow = true;
+        ++_counters.overflows;
+    }
+
+    /** Whether the breakpoint at the given location should stop the execution. */
+    [[nodiscard]] bool triggerBreakpoint(int32_t address);
+    /** Find the first watched location the instruction is going to access, -1 if there is none. */
+    int32_t findWatchedAddress(const InstructionWord& instruction, StopReason* reason);
+
+    /** Get the address of the instruction without checking or throwing, -1 if the index is invalid. */
+    [[nodiscard]] int32_t peekIndexedAddress(const InstructionWord& instruction) const;
+    /** Clear the sampled states and mark the memory hash as outdated. */
+    void resetLoopDetection();
+    /** Clear the sampled states. */
+    void clearLoopSamples();
+    /** Execute the instruction with the memory hash updated, return true if the state after it repeats. */
+    bool executeDetectingLoop(const InstructionWord& instruction);
+    /** Remove the words that are going to be written by the instruction from the memory hash. */
+    void beforeLoopDetection(const InstructionWord& instruction, int32_t* writeStart, int32_t* writeLength);
+    /** Add the hashes of the words in the range to the memory hash. */
+    void hashMemory(int32_t start, int32_t length);
+    /** Sample the current state and check whether it has been seen. */
+    bool detectLoop();
 
-    int32_t checkRange(int32_t value, int bytes = 5);
+    /** Find the resource that would be exceeded by executing the instruction. */
+    ResourceKind checkResourceLimits(const InstructionWord& instruction, int64_t steps);
+    /** Raise a fault if the instruction at the current location would exceed a resource limit. */
+    void enforceResourceLimits();
 
-    /** Get one byte from the unit value of rA and rX. */
-    [[nodiscard]] uint8_t getAX(int index) const;
-    /** Set one byte to the unit value of rA and rX. */
-    void setAX(int index, uint8_t value);
+    /** Get the index register in [1, 6], or the zero register for 0, without checking. */
+    Register2& indexRegister(const int index) { return this->*INDEX_REGISTERS[index]; }
+    /** The bytes of rA followed by the bytes of rX as one number, only used when 10 bytes fit in 64 bits. */
+    [[nodiscard]] uint64_t unitsAX() const;
+    /** Set the bytes of rA and rX from one number, the signs are kept. */
+    void setUnitsAX(uint64_t units);
+    /** Shift the 10 bytes of rA and rX to the left for positive amounts and to the right for negative ones. */
+    void shiftAX(int32_t amount, bool circular);
 
     void executeADD(const InstructionWord& instruction);
     void executeSUB(const InstructionWord& instruction);
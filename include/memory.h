@@ -1,19 +1,101 @@
 #ifndef INCLUDE_MEMORY_H_
 #define INCLUDE_MEMORY_H_
 
+#include <array>
+#include <bit>
 #include <cstdint>
+#include <limits>
 #include <string>
+#include <string_view>
 #include <cmath>
+#include <type_traits>
 
 /**
  * @file
  * @brief The definition of a computer word.
  */
 
+#ifndef MIXAL_BYTE_SIZE
+#define MIXAL_BYTE_SIZE 64
+#endif
+
 namespace mixal {
 
 class Instructions;
 
+/** The arithmetic of bytes that hold `BASE` values, resolved at compile time.
+ *
+ * TAOCP allows any byte size from 64 to 100. A power of two is handled with shifts and masks,
+ * the other sizes, such as 100 of the decimal MIX, with a table of the powers of the base.
+ * The values given to the functions are non-negative.
+ */
+template<int32_t BASE>
+struct ByteFormat {
+    static_assert(64 <= BASE && BASE <= 100, "A byte holds from 64 to 100 values");
+
+    static constexpr bool BINARY = (BASE & (BASE - 1)) == 0;  /**< Whether the base is a power of two. */
+    static constexpr int BITS = BINARY ? std::countr_zero(static_cast<uint32_t>(BASE)) : 0;  /**< Bits of a binary byte. */
+    static constexpr int MAX_BYTES = 9;  /**< The most bytes whose values fit in 64 bits. */
+
+    /** The powers of the base from 0 to `MAX_BYTES`. */
+    static constexpr std::array<int64_t, MAX_BYTES + 1> POWERS = [] {
+        std::array<int64_t, MAX_BYTES + 1> powers{};
+        powers[0] = 1;
+        for (int i = 1; i <= MAX_BYTES; ++i) {
+            powers[i] = powers[i - 1] * BASE;
+        }
+        return powers;
+    }();
+
+    /** The number of values that the bytes can represent. */
+    static constexpr int64_t power(const int bytes) {
+        if constexpr (BINARY) {
+            return int64_t{1} << (BITS * bytes);
+        } else {
+            return POWERS[bytes];
+        }
+    }
+    /** Append a byte to the lowest end of a value. */
+    template<typename T>
+    static constexpr T combine(const T high, const T low) {
+        if constexpr (BINARY) {
+            return static_cast<T>(high << BITS | low);
+        } else {
+            return static_cast<T>(high * BASE + low);
+        }
+    }
+    /** Drop the lowest bytes of a value. */
+    template<typename T>
+    static constexpr T shiftRight(const T value, const int bytes) {
+        if constexpr (BINARY) {
+            return static_cast<T>(value >> (BITS * bytes));
+        } else {
+            return static_cast<T>(value / POWERS[bytes]);
+        }
+    }
+    /** Keep the lowest bytes of a value. */
+    template<typename T>
+    static constexpr T lowBytes(const T value, const int bytes) {
+        if constexpr (BINARY) {
+            return static_cast<T>(value & ((T{1} << (BITS * bytes)) - 1));
+        } else {
+            return static_cast<T>(value % POWERS[bytes]);
+        }
+    }
+    /** The byte of a value at the position, 0 is the lowest. */
+    template<typename T>
+    static constexpr uint8_t byteAt(const T value, const int position) {
+        return static_cast<uint8_t>(lowBytes(shiftRight(value, position), 1));
+    }
+};
+
+/** The number of values of a byte, set with `MIXAL_BYTE_SIZE` when building, 100 for the decimal MIX. */
+constexpr int32_t BYTE_SIZE = MIXAL_BYTE_SIZE;
+/** The byte arithmetic of the machine. */
+using WordFormat = ByteFormat<BYTE_SIZE>;
+/** The integer that holds the value of a word, 64 bits only when 5 bytes do not fit in 32 bits. */
+using WordValue = std::conditional_t<WordFormat::power(5) <= std::numeric_limits<int32_t>::max(), int32_t, int64_t>;
+
 extern uint16_t CHAR_CODES[];       /**< The mapping from a byte to the characters. */
 constexpr int32_t CHAR_CODES_NUM = 56;  /**< The maximum number of characters in the mapping. */
 
@@ -21,7 +103,7 @@ constexpr int32_t CHAR_CODES_NUM = 56;  /**< The maximum number of characters in
  * Basic definition of a word.
  * 
  * A word contains a sign indicator (`+` or `-`) and 5 bytes.
- * Each byte can represent at least [0, 64) integers.
+ * Each byte can represent [0, BYTE_SIZE) integers.
  */
 struct ComputerWord {
     bool negative;
@@ -31,15 +113,16 @@ struct ComputerWord {
     uint8_t byte4;
     uint8_t byte5;
 
-    static constexpr int MIX_FLOAT_BIAS = 32;
+    static constexpr int MIX_FLOAT_BIAS = BYTE_SIZE / 2;
+    static constexpr int MIX_FLOAT_DIGITS = 4;  /**< The bytes of the fraction of a float. */
 
     /** Initialize with 0s. The default sign is '+'. */
     ComputerWord();
     /** Initialize with integer value.
      * 
-     * @see set(int32_t)
+     * @see set(int64_t)
      */
-    explicit ComputerWord(int32_t value);
+    explicit ComputerWord(WordValue value);
     /** Initialize with five characters.
      * 
      * @see set(const std::string&)
@@ -117,13 +200,16 @@ struct ComputerWord {
     [[nodiscard]] uint16_t bytes45() const;
     /** Get the value the word represents.
      * 
-     * The range of the result should be [-1073741824, 1073741824].
+     * The absolute value of the result is less than `BYTE_SIZE` to the power of 5,
+     * which is 1073741824 for binary bytes.
      */
-    [[nodiscard]] int32_t value() const;
+    [[nodiscard]] WordValue value() const;
     /**
      * Get the float-pointing number of this word.
      */
     [[nodiscard]] double floatValue() const;
+    /** Get the fraction of the float-pointing number, which is the last four bytes combined. */
+    [[nodiscard]] int64_t floatFraction() const;
 
     /** When representing an instruction,
      * the function returns the value represented by the first two bytes with the sign.
@@ -148,14 +234,14 @@ struct ComputerWord {
     /** When representing an instruction,
      * the function returns the field value of the instruction.
      * 
-     * @return The value should be in [0, 63].
+     * @return The value should be in [0, BYTE_SIZE).
      *         For most of the operations the default field value is 5.
      */
     [[nodiscard]] uint8_t field() const { return byte4; }
     /** When representing an instruction,
      * the function returns the type of operation of the instruction.
      * 
-     * @return The value should be in [0, 63].
+     * @return The value should be in [0, BYTE_SIZE).
      */
     [[nodiscard]] uint8_t operation() const { return byte5; }
 
@@ -186,8 +272,14 @@ struct ComputerWord {
      * Therefore, to set the word to `-0` with this function,
      * one can set it with a negative value first, then set it to 0.
      * 
-     * The least significant 30 bits will be saved to the word.
-     * Each byte contains 6 bits. The byte5 will contain the least significant 6 bits. 
+     * The value modulo `BYTE_SIZE` to the power of 5 will be saved to the word,
+     * which is the least significant 30 bits for binary bytes.
+     * The byte5 will contain the least significant byte.
+     */
+    void set(int64_t value);
+    /** Set the word with an integer.
+     *
+     * @see set(int64_t)
      */
     void set(int32_t value);
     /**
@@ -198,6 +290,20 @@ struct ComputerWord {
      * @return Overflow
      */
     bool set(double value);
+    /**
+     * Set the word with the float `fraction / BYTE_SIZE^digits * BYTE_SIZE^(exponent - MIX_FLOAT_BIAS)`.
+     *
+     * The fraction is normalized and rounded to four bytes with Algorithm 4.2.1N of TAOCP,
+     * a tie is rounded to the fraction that becomes odd when half of `BYTE_SIZE` is added.
+     * A zero fraction sets `+0`.
+     *
+     * @param fraction The non-negative fraction, with at most `MAX_BYTES` bytes.
+     * @param digits The bytes of the fraction below the radix point, at least four.
+     * @param inexact Whether the exact fraction is slightly greater than the given one.
+     *
+     * @return Overflow, the exponent has left [0, BYTE_SIZE) and is kept modulo `BYTE_SIZE`.
+     */
+    bool setFloat(bool negative, int32_t exponent, int64_t fraction, int digits, bool inexact = false);
     /**
      * Set the word with a UTF8 string.
      * 
@@ -214,7 +320,7 @@ struct ComputerWord {
      * Set specific byte with the given index in [1, 5].
      * 
      * @param index
-     * @param val The behavior is undefined if it is greater than 63.
+     * @param val The behavior is undefined if it is not less than `BYTE_SIZE`.
      * 
      * @throw std::runtime_error when the index is not in [1, 5].
      */
@@ -230,7 +336,7 @@ struct ComputerWord {
      *  Set all the values.
      * 
      * @param _negative
-     * @param bytes12 Use the first two bytes to represent an integer within 4096.
+     * @param bytes12 Use the first two bytes to represent an integer less than `BYTE_SIZE` squared.
      *                The behavior is undefined if the number can not be represented.
      * @param _byte3
      * @param _byte4
@@ -241,7 +347,7 @@ struct ComputerWord {
      *  Set all the values.
      * 
      * @param sign
-     * @param bytes12 Use the first two bytes to represent an integer within 4096.
+     * @param bytes12 Use the first two bytes to represent an integer less than `BYTE_SIZE` squared.
      *                The behavior is undefined if the number can not be represented.
      * @param _byte3
      * @param _byte4
@@ -252,6 +358,22 @@ struct ComputerWord {
     void set(char sign, uint16_t bytes12, uint8_t _byte3, uint8_t _byte4, uint8_t _byte5);
 };
 
+static_assert(std::is_trivially_copyable_v<ComputerWord>, "Blocks of words are copied in bulk.");
+
+/** Convert UTF-8 text to the characters of consecutive words in one pass.
+ *
+ * The text is padded with spaces or truncated to `5 * count` characters,
+ * the characters that are not in the mapping become spaces, and the signs are set to `+`.
+ *
+ * @return The number of characters in the whole text.
+ */
+size_t textToWords(std::string_view text, ComputerWord* words, int32_t count);
+/** Convert the characters of consecutive words to UTF-8 text in one pass.
+ *
+ * The bytes that are not in the mapping become spaces.
+ */
+std::string wordsToText(const ComputerWord* words, int32_t count);
+
 }  // namespace mixal
 
 
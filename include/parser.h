@@ -48,6 +48,7 @@ class ParsedResult {
     std::string rawLocation;  /**< Raw string of the location name. */
     Expression location;      /**< The location expression. */
     std::string operation;    /**< Raw string of the operation name. */
+    int32_t defaultField;     /**< The field implied by the operation name, -1 if there is none. */
     std::string rawAddress;   /**< Raw string of the base address. */
     Expression address;       /**< The parsed base address expression. */
     std::string rawIndex;     /**< Raw string of the index. */
@@ -66,7 +67,7 @@ class ParsedResult {
     TokenSpan commentSpan;    /**< Span of the comment. */
 
     /** Initialize the parsed result with empties. */
-    ParsedResult() : parsedType(ParsedType::EMPTY) {}
+    ParsedResult() : parsedType(ParsedType::EMPTY), defaultField(-1) {}
 
     /** Evaluate base address, index, and field expressions. */
     bool evaluate(const std::unordered_map<std::string, AtomicValue>& constants);
@@ -18,7 +18,7 @@ using Register5 = ComputerWord;
  *
  * The 2 bytes registers are used to represent locations and offsets.
  * It contains a sign indicator (`+` or `-`) and 2 bytes.
- * Each byte can represent at least [0, 64) integers.
+ * Each byte can represent [0, BYTE_SIZE) integers.
  */
 struct Register2 {
     bool negative;
@@ -67,15 +67,16 @@ struct Register2 {
      * Therefore, to set the word to `-0` with this function,
      * one can set it with a negative value first, then set it to 0.
      * 
-     * The least significant 12 bits will be saved to the word.
-     * Each byte contains 6 bits. The byte2 will contain the least significant 6 bits. 
+     * The value modulo `BYTE_SIZE` squared will be saved to the register,
+     * which is the least significant 12 bits for binary bytes.
+     * The byte2 will contain the least significant byte.
      */
     void set(int16_t value);
     /**
      * Set specific byte with the given index in [1, 2].
      * 
      * @param index
-     * @param val The behavior is undefined if it is greater than 63.
+     * @param val The behavior is undefined if it is not less than `BYTE_SIZE`.
      * 
      * @throw std::runtime_error when the index is not in [1, 2].
      */
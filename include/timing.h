@@ -0,0 +1,99 @@
+#ifndef INCLUDE_TIMING_H_
+#define INCLUDE_TIMING_H_
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+#include "machine.h"
+
+/**
+ * @file
+ * @brief Static timing analysis of a loaded program.
+ */
+
+namespace mixal {
+
+/** A product of symbols with a coefficient. */
+struct CostTerm {
+    int64_t coefficient = 0;
+    std::vector<std::string> symbols;  /**< The sorted symbols, empty for a constant. */
+};
+
+/** A polynomial of the execution counts, in the form of the running times in TAOCP. */
+struct CostExpression {
+    std::vector<CostTerm> terms;  /**< The non-zero terms ordered by their degrees and then their symbols. */
+
+    /** Evaluate the expression with the values of the symbols.
+     *
+     * @throw std::runtime_error when a symbol of the expression has no value.
+     */
+    [[nodiscard]] int64_t evaluate(const std::map<std::string, int64_t>& values = {}) const;
+    /** Get the expression as a string such as `3 + 4*L1001 + 2*L1001*L1005`. */
+    [[nodiscard]] std::string toString() const;
+};
+
+/** A run of instructions that is only entered at its first location and only left after its last one. */
+struct TimingBlock {
+    int32_t start = 0;   /**< The location of the first instruction. */
+    int32_t length = 0;  /**< The number of instructions. */
+    int64_t cost = 0;    /**< The unit time of one execution, `HLT` costs nothing as in the machine. */
+    std::vector<int32_t> successors;  /**< The starts of the blocks that may follow, excluding the called subroutines. */
+    int32_t loop = -1;     /**< The index of the innermost loop that contains the block, -1 if there is none. */
+    CostExpression count;  /**< The number of executions. */
+};
+
+/** A natural loop, which is formed by the backward jumps to its header. */
+struct TimingLoop {
+    int32_t header = 0;   /**< The start of the first block of the loop. */
+    int32_t latch = 0;    /**< The location of the last backward jump to the header. */
+    int32_t parent = -1;  /**< The index of the enclosing loop, -1 if there is none. */
+    int32_t counter = 0;  /**< The index register tested by the backward jump such as `J1P`, 0 if it is not one. */
+    /** The executions of the header per entry of the loop, -1 if it is unknown.
+     *
+     * It is inferred when the counter is set to a constant with `ENTi` or `ENNi` in the only block that enters the loop,
+     * and only changed with constant `INCi` and `DECi` before the backward jump.
+     */
+    int64_t iterations = -1;
+    std::string symbol;   /**< The symbol of the unknown iterations, which is `L` followed by the header. */
+    std::vector<int32_t> blocks;  /**< The starts of the blocks in the loop, including the inner loops. */
+    /** The unit time of one entry of the loop, including the subroutines it calls.
+     *
+     * A subroutine that calls itself, directly or through others, costs `T` followed by its location per call.
+     */
+    CostExpression cost;
+};
+
+/** The result of `analyzeTiming`. */
+struct TimingAnalysis {
+    std::vector<TimingBlock> blocks;  /**< The reachable blocks ordered by their locations. */
+    std::vector<TimingLoop> loops;    /**< The loops ordered by their headers. */
+    CostExpression cost;              /**< The unit time of the program. */
+
+    /** Predict the elapsed time of a run with the iterations of the loops that have not been inferred. */
+    [[nodiscard]] int64_t estimate(const std::map<std::string, int64_t>& iterations = {}) const {
+        return cost.evaluate(iterations);
+    }
+};
+
+/** Analyze the running time of the program in the memory of the machine without executing it.
+ *
+ * The control-flow graph is built from the entry, the interrupt handler and the called subroutines,
+ * following the constant targets of the jumps. A jump whose location is written by a store,
+ * such as the `JMP *` that returns from a subroutine, has no known target.
+ * A `JMP` to a location that starts with `STJ` is a call, it continues after the jump,
+ * and the subroutine is executed once per execution of the calling block.
+ *
+ * Every block of a loop is counted once per iteration of the loop, so the result is exact for the loops
+ * without branches, and an upper bound otherwise. The waiting time of the devices is not included,
+ * and the interrupts happen `INT` times.
+ *
+ * @param machine The machine with the loaded program.
+ * @param entry The location where the program starts.
+ */
+TimingAnalysis analyzeTiming(const Computer& machine, int32_t entry);
+
+}  // namespace mixal
+
+
+#endif  // INCLUDE_TIMING_H_
@@ -0,0 +1,90 @@
+#ifndef INCLUDE_TRACE_H_
+#define INCLUDE_TRACE_H_
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/**
+ * @file
+ * @brief Timeline of the activities of IO devices.
+ */
+
+namespace mixal {
+
+/** The kind of a recorded device event. */
+enum class DeviceEventType : uint8_t {
+    ISSUE,     /**< The instruction of the operation is met. */
+    START,     /**< The device accepts the operation after the previous one has been finished. */
+    COMPLETE,  /**< The device is found ready again. */
+    WAIT,      /**< The machine stalls until the device is ready. */
+    POLL,      /**< Iterations of an idle polling loop skipped at once. */
+};
+
+/** A device event with the simulated time. */
+struct DeviceEvent {
+    int64_t timestamp;      /**< The unit time when the event starts. */
+    int64_t duration;       /**< The length of `WAIT` and `POLL`, zero for the others. */
+    int32_t unit;           /**< The device unit. */
+    DeviceEventType type;   /**< The kind of the event. */
+    uint8_t operation;      /**< The operation code of `ISSUE` and `START`: IOC, IN or OUT. */
+};
+
+/** Records device events in a ring buffer allocated once.
+ *
+ * The oldest events are overwritten when the buffer is full, so the recording never allocates
+ * and the cost of a long run stays constant.
+ */
+class DeviceTrace {
+ public:
+    /** Initialize the buffer, a zero capacity disables the recording. */
+    explicit DeviceTrace(size_t capacity = 0);
+
+    /** Whether the events are recorded. */
+    [[nodiscard]] bool enabled() const { return !_events.empty(); }
+    /** The maximum number of events kept. */
+    [[nodiscard]] size_t capacity() const { return _events.size(); }
+    /** The number of events kept. */
+    [[nodiscard]] size_t size() const { return _size; }
+    /** The number of events that have been overwritten. */
+    [[nodiscard]] int64_t dropped() const { return _dropped; }
+
+    /** Add an event, overwriting the oldest one when the buffer is full. */
+    void record(const DeviceEvent& event) {
+        _events[_next] = event;
+        if (++_next == _events.size()) {
+            _next = 0;
+        }
+        if (_size < _events.size()) {
+            ++_size;
+        } else {
+            ++_dropped;
+        }
+    }
+    /** Remove all the events and keep the capacity. */
+    void clear();
+    /** Get the kept events from the oldest to the newest. */
+    [[nodiscard]] std::vector<DeviceEvent> events() const;
+
+    /** Write the events in the Chrome trace event format, which can be opened by Perfetto.
+     *
+     * One unit time is exported as one microsecond. The CPU and each used unit get their own tracks,
+     * the operations are shown as spans from `START` to `COMPLETE` on the tracks of the units,
+     * the issues, the waits and the skipped polling loops are shown on the track of the CPU.
+     */
+    void writeChromeTrace(std::ostream& out) const;
+    /** Get the events in the Chrome trace event format. */
+    [[nodiscard]] std::string toChromeTrace() const;
+
+ private:
+    std::vector<DeviceEvent> _events;  /**< The ring buffer. */
+    size_t _next;      /**< The slot of the next event. */
+    size_t _size;      /**< The number of kept events. */
+    int64_t _dropped;  /**< The number of overwritten events. */
+};
+
+}  // namespace mixal
+
+
+#endif  // INCLUDE_TRACE_H_
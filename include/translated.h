@@ -0,0 +1,167 @@
+#ifndef INCLUDE_TRANSLATED_H_
+#define INCLUDE_TRANSLATED_H_
+
+#include "machine.h"
+
+/**
+ * @file
+ * @brief Runtime support of the programs generated by `translateToCpp`.
+ */
+
+namespace mixal {
+
+/** The interface between a translated program and the machine.
+ *
+ * Every translated instruction calls the same operation of the machine as the interpreter,
+ * so the registers, the memory, the devices and the elapsed time stay identical.
+ * Only fetching, decoding and the dispatch of the control flow are done natively.
+ */
+struct TranslatedRuntime {
+    /** The location of the next instruction. */
+    static int32_t line(const Computer& machine) { return machine._lineOffset; }
+    /** Whether the memory still contains the translated instruction. */
+    static bool same(const Computer& machine, const int32_t location, const InstructionWord& word) {
+        return machine.memory[location] == word;
+    }
+    /** Finish an instruction with its precomputed cost. */
+    static void retire(Computer& machine, const int operation, const int field, const int64_t cost) {
+        machine.retire(operation, field, cost);
+    }
+    /** Execute HLT and wait for the devices. */
+    static void halt(Computer& machine) {
+        ++machine._lineOffset;
+        machine.waitDevices();
+    }
+    /** Interpret the instruction at the current location, return true if it is HLT. */
+    static bool interpret(Computer& machine) {
+        if (machine.stepOrHalt()) {
+            machine.waitDevices();
+            return true;
+        }
+        if (machine.faulted()) {
+            machine.throwFault();
+        }
+        return false;
+    }
+
+    /** Execute the operation selected at compile time, the errors are thrown. */
+    template<int C, int F>
+    static void execute(Computer& m, const InstructionWord& w) {
+        if (!tryExecute<C, F>(m, w)) {
+            m.throwFault();
+        }
+    }
+
+    /** Execute the operation selected at compile time, the same as `Computer::executeSingle` without retiring it.
+     *
+     * @return false if the operation has raised an error, which is kept in the machine.
+     */
+    template<int C, int F>
+    static bool tryExecute(Computer& m, const InstructionWord& w) {
+        if constexpr (C == Instructions::ADD) {
+            if constexpr (F == 6) { m.executeFADD(w); } else { m.executeADD(w); }
+        } else if constexpr (C == Instructions::SUB) {
+            if constexpr (F == 6) { m.executeFSUB(w); } else { m.executeSUB(w); }
+        } else if constexpr (C == Instructions::MUL) {
+            if constexpr (F == 6) { m.executeFMUL(w); } else { m.executeMUL(w); }
+        } else if constexpr (C == Instructions::DIV) {
+            if constexpr (F == 6) { m.executeFDIV(w); } else { m.executeDIV(w); }
+        } else if constexpr (C == Instructions::HLT) {
+            if constexpr (F == 0) { m.executeNUM(); }
+            else if constexpr (F == 1) { m.executeCHAR(); }
+            else if constexpr (F == 6) { m.executeFLOT(); }
+            else if constexpr (F == 7) { m.executeFIX(); }
+            else if constexpr (F == 9) { m.executeINT(); }
+        } else if constexpr (C == Instructions::SLA) {
+            if constexpr (F == 0) { m.executeSLA(w); }
+            else if constexpr (F == 1) { m.executeSRA(w); }
+            else if constexpr (F == 2) { m.executeSLAX(w); }
+            else if constexpr (F == 3) { m.executeSRAX(w); }
+            else if constexpr (F == 4) { m.executeSLC(w); }
+            else if constexpr (F == 5) { m.executeSRC(w); }
+        } else if constexpr (C == Instructions::MOVE) {
+            m.executeMOVE(w);
+        } else if constexpr (C == Instructions::LDA) {
+            m.executeLD(w, &m.rA);
+        } else if constexpr (Instructions::LD1 <= C && C <= Instructions::LD6) {
+            m.executeLDi(w);
+        } else if constexpr (C == Instructions::LDX) {
+            m.executeLD(w, &m.rX);
+        } else if constexpr (C == Instructions::LDAN) {
+            m.executeLDN(w, &m.rA);
+        } else if constexpr (Instructions::LD1N <= C && C <= Instructions::LD6N) {
+            m.executeLDiN(w);
+        } else if constexpr (C == Instructions::LDXN) {
+            m.executeLDN(w, &m.rX);
+        } else if constexpr (C == Instructions::STA) {
+            m.executeST(w, &m.rA);
+        } else if constexpr (Instructions::ST1 <= C && C <= Instructions::ST6) {
+            m.executeSTi(w);
+        } else if constexpr (C == Instructions::STX) {
+            m.executeST(w, &m.rX);
+        } else if constexpr (C == Instructions::STJ) {
+            m.executeSTJ(w);
+        } else if constexpr (C == Instructions::STZ) {
+            m.executeSTZ(w);
+        } else if constexpr (C == Instructions::JBUS) {
+            m.executeJBUS(w);
+        } else if constexpr (C == Instructions::IOC) {
+            m.executeIOC(w);
+        } else if constexpr (C == Instructions::IN) {
+            m.executeIN(w);
+        } else if constexpr (C == Instructions::OUT) {
+            m.executeOUT(w);
+        } else if constexpr (C == Instructions::JRED) {
+            m.executeJRED(w);
+        } else if constexpr (C == Instructions::JMP) {
+            if constexpr (F == 0) { m.executeJMP(w); }
+            else if constexpr (F == 1) { m.executeJSJ(w); }
+            else if constexpr (F == 2) { m.executeJOV(w); }
+            else if constexpr (F == 3) { m.executeJNOV(w); }
+            else if constexpr (F == 4) { m.executeJL(w); }
+            else if constexpr (F == 5) { m.executeJE(w); }
+            else if constexpr (F == 6) { m.executeJG(w); }
+            else if constexpr (F == 7) { m.executeJGE(w); }
+            else if constexpr (F == 8) { m.executeJNE(w); }
+            else if constexpr (F == 9) { m.executeJLE(w); }
+        } else if constexpr (C == Instructions::JAN || C == Instructions::JXN) {
+            auto reg = C == Instructions::JAN ? &m.rA : &m.rX;
+            if constexpr (F == 0) { m.executeJN(w, reg); }
+            else if constexpr (F == 1) { m.executeJZ(w, reg); }
+            else if constexpr (F == 2) { m.executeJP(w, reg); }
+            else if constexpr (F == 3) { m.executeJNN(w, reg); }
+            else if constexpr (F == 4) { m.executeJNZ(w, reg); }
+            else if constexpr (F == 5) { m.executeJNP(w, reg); }
+        } else if constexpr (Instructions::J1N <= C && C <= Instructions::J6N) {
+            if constexpr (F == 0) { m.executeJiN(w); }
+            else if constexpr (F == 1) { m.executeJiZ(w); }
+            else if constexpr (F == 2) { m.executeJiP(w); }
+            else if constexpr (F == 3) { m.executeJiNN(w); }
+            else if constexpr (F == 4) { m.executeJiNZ(w); }
+            else if constexpr (F == 5) { m.executeJiNP(w); }
+        } else if constexpr (C == Instructions::INCA || C == Instructions::INCX) {
+            auto reg = C == Instructions::INCA ? &m.rA : &m.rX;
+            if constexpr (F == 0) { m.executeINC(w, reg); }
+            else if constexpr (F == 1) { m.executeDEC(w, reg); }
+            else if constexpr (F == 2) { m.executeENT(w, reg); }
+            else if constexpr (F == 3) { m.executeENN(w, reg); }
+        } else if constexpr (Instructions::INC1 <= C && C <= Instructions::INC6) {
+            if constexpr (F == 0) { m.executeINCi(w); }
+            else if constexpr (F == 1) { m.executeDECi(w); }
+            else if constexpr (F == 2) { m.executeENTi(w); }
+            else if constexpr (F == 3) { m.executeENNi(w); }
+        } else if constexpr (C == Instructions::CMPA) {
+            if constexpr (F == 6) { m.executeFCMP(w); } else { m.executeCMP(w, &m.rA); }
+        } else if constexpr (Instructions::CMP1 <= C && C <= Instructions::CMP6) {
+            m.executeCMPi(w);
+        } else if constexpr (C == Instructions::CMPX) {
+            m.executeCMP(w, &m.rX);
+        }
+        return !m.faulted();
+    }
+};
+
+}  // namespace mixal
+
+
+#endif  // INCLUDE_TRANSLATED_H_
@@ -0,0 +1,45 @@
+#ifndef INCLUDE_TRANSLATOR_H_
+#define INCLUDE_TRANSLATOR_H_
+
+#include <cstdint>
+#include <string>
+#include "machine.h"
+
+/**
+ * @file
+ * @brief Ahead-of-time translation of a loaded program to C++.
+ */
+
+namespace mixal {
+
+/** The signature of the function generated by `translateToCpp`. */
+using TranslatedProgram = int64_t (*)(Computer&);
+
+/** Options of the generated source. */
+struct TranslationOptions {
+    std::string functionName = "mixal_translated";  /**< The exported `extern "C"` function. */
+};
+
+/** Translate the program in the memory of the machine to a C++ source.
+ *
+ * The instructions reachable from the entry, the interrupt handler and the return locations of jumps
+ * are emitted as labelled straight-line code that calls the operations of the machine,
+ * and the jumps between them become gotos. The generated function behaves as `executeUntilHalt()`
+ * from the current location of the machine it is given, and includes `translated.h`.
+ * It returns the number of executed instructions that have not been interpreted.
+ *
+ * The cells written by stores with constant addresses anywhere in the memory are always interpreted,
+ * since any word may be executed through a computed jump. If any word may write to computed addresses,
+ * each translated instruction is compared with the memory before executing it, and a modified cell
+ * is interpreted instead. Locations that have not been translated are interpreted until the control
+ * reaches a translated one.
+ *
+ * @param machine The machine with the loaded program.
+ * @param entry The location where the program starts.
+ */
+std::string translateToCpp(const Computer& machine, int32_t entry, const TranslationOptions& options = {});
+
+}  // namespace mixal
+
+
+#endif  // INCLUDE_TRANSLATOR_H_
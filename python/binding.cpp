@@ -1,8 +1,11 @@
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
+#include <fstream>
 #include <string>
 #include <memory>
 #include "machine.h"
+#include "timing.h"
+#include "translator.h"
 #include "../include/memory.h"
 using namespace std;
 using namespace mixal;
@@ -18,7 +21,7 @@ PYBIND11_MODULE(_core, m, py::mod_gil_not_used()) {
         .def_readwrite("byte3", &ComputerWord::byte3)
         .def_readwrite("byte4", &ComputerWord::byte4)
         .def_readwrite("byte5", &ComputerWord::byte5)
-        .def("set", py::overload_cast<int32_t>(&ComputerWord::set), py::arg("value"))
+        .def("set", py::overload_cast<WordValue>(&ComputerWord::set), py::arg("value"))
         .def("set", py::overload_cast<double>(&ComputerWord::set), py::arg("value"))
         .def("set", py::overload_cast<const string&>(&ComputerWord::set), py::arg("value"))
         .def("set", py::overload_cast<int, uint8_t>(&ComputerWord::set), py::arg("index"), py::arg("value"))
@@ -38,6 +41,151 @@ PYBIND11_MODULE(_core, m, py::mod_gil_not_used()) {
         .def("value", &Register2::value)
         .def("get_bytes_str", &Register2::getBytesString)
     ;
+    py::enum_<StopReason>(m, "StopReason")
+        .value("HALT", StopReason::HALT)
+        .value("SELF_LOOP", StopReason::SELF_LOOP)
+        .value("BREAKPOINT", StopReason::BREAKPOINT)
+        .value("WATCH_READ", StopReason::WATCH_READ)
+        .value("WATCH_WRITE", StopReason::WATCH_WRITE)
+        .value("ERROR", StopReason::ERROR)
+        .value("BUDGET_EXHAUSTED", StopReason::BUDGET_EXHAUSTED)
+        .value("WAITING_FOR_INPUT", StopReason::WAITING_FOR_INPUT)
+        .value("RESOURCE_LIMIT", StopReason::RESOURCE_LIMIT)
+        .value("NON_TERMINATING_LOOP", StopReason::NON_TERMINATING_LOOP)
+    ;
+    py::enum_<ResourceKind>(m, "ResourceKind")
+        .value("NONE", ResourceKind::NONE)
+        .value("PRINTED_LINES", ResourceKind::PRINTED_LINES)
+        .value("PUNCHED_CARDS", ResourceKind::PUNCHED_CARDS)
+        .value("TAPE_BLOCKS", ResourceKind::TAPE_BLOCKS)
+        .value("DISK_BLOCKS", ResourceKind::DISK_BLOCKS)
+        .value("MOVED_WORDS", ResourceKind::MOVED_WORDS)
+        .value("ELAPSED", ResourceKind::ELAPSED)
+        .value("WALL_CLOCK", ResourceKind::WALL_CLOCK)
+    ;
+    py::enum_<FaultCode>(m, "FaultCode")
+        .value("NONE", FaultCode::NONE)
+        .value("INVALID_LINE", FaultCode::INVALID_LINE)
+        .value("INVALID_INDEX", FaultCode::INVALID_INDEX)
+        .value("INVALID_ADDRESS", FaultCode::INVALID_ADDRESS)
+        .value("INVALID_FIELD", FaultCode::INVALID_FIELD)
+        .value("DIVISION_BY_ZERO", FaultCode::DIVISION_BY_ZERO)
+        .value("FLOAT_DIVISION_BY_ZERO", FaultCode::FLOAT_DIVISION_BY_ZERO)
+        .value("INT_OUTSIDE_HANDLER", FaultCode::INT_OUTSIDE_HANDLER)
+        .value("READ_NOT_SUPPORTED", FaultCode::READ_NOT_SUPPORTED)
+        .value("WRITE_NOT_SUPPORTED", FaultCode::WRITE_NOT_SUPPORTED)
+        .value("BLOCK_OUT_OF_MEMORY", FaultCode::BLOCK_OUT_OF_MEMORY)
+        .value("RESOURCE_LIMIT", FaultCode::RESOURCE_LIMIT)
+        .value("INVALID_DEVICE", FaultCode::INVALID_DEVICE)
+        .value("NULL_DEVICE", FaultCode::NULL_DEVICE)
+    ;
+    py::class_<Fault>(m, "Fault")
+        .def_readonly("code", &Fault::code)
+        .def_readonly("line", &Fault::line)
+        .def_readonly("instruction", &Fault::instruction)
+        .def_readonly("operand", &Fault::operand)
+        .def_readonly("block_size", &Fault::blockSize)
+        .def("message", &Fault::message)
+    ;
+    py::class_<StopInfo>(m, "StopInfo")
+        .def_readonly("reason", &StopInfo::reason)
+        .def_readonly("line", &StopInfo::line)
+        .def_readonly("address", &StopInfo::address)
+        .def_readonly("message", &StopInfo::message)
+        .def_readonly("resource", &StopInfo::resource)
+        .def_readonly("fault", &StopInfo::fault)
+    ;
+    py::class_<ResourceLimits>(m, "ResourceLimits")
+        .def(py::init<>())
+        .def_readwrite("printed_lines", &ResourceLimits::printedLines)
+        .def_readwrite("punched_cards", &ResourceLimits::punchedCards)
+        .def_readwrite("tape_blocks", &ResourceLimits::tapeBlocks)
+        .def_readwrite("disk_blocks", &ResourceLimits::diskBlocks)
+        .def_readwrite("moved_words", &ResourceLimits::movedWords)
+        .def_readwrite("elapsed", &ResourceLimits::elapsed)
+        .def_readwrite("wall_clock_milliseconds", &ResourceLimits::wallClockMilliseconds)
+        .def_readwrite("wall_clock_check_interval", &ResourceLimits::wallClockCheckInterval)
+    ;
+    py::class_<ResourceUsage>(m, "ResourceUsage")
+        .def_readonly("printed_lines", &ResourceUsage::printedLines)
+        .def_readonly("punched_cards", &ResourceUsage::punchedCards)
+        .def_readonly("tape_blocks", &ResourceUsage::tapeBlocks)
+        .def_readonly("disk_blocks", &ResourceUsage::diskBlocks)
+        .def_readonly("moved_words", &ResourceUsage::movedWords)
+    ;
+    py::class_<PerformanceCounters>(m, "PerformanceCounters")
+        .def_readonly("steps", &PerformanceCounters::steps)
+        .def_readonly("elapsed", &PerformanceCounters::elapsed)
+        .def_readonly("instructions", &PerformanceCounters::instructions)
+        .def_readonly("memory_reads", &PerformanceCounters::memoryReads)
+        .def_readonly("memory_writes", &PerformanceCounters::memoryWrites)
+        .def_readonly("jumps_taken", &PerformanceCounters::jumpsTaken)
+        .def_readonly("jumps_not_taken", &PerformanceCounters::jumpsNotTaken)
+        .def_readonly("overflows", &PerformanceCounters::overflows)
+        .def_readonly("moved_words", &PerformanceCounters::movedWords)
+        .def_readonly("device_wait_cycles", &PerformanceCounters::deviceWaitCycles)
+        .def_readonly("device_input_words", &PerformanceCounters::deviceInputWords)
+        .def_readonly("device_output_words", &PerformanceCounters::deviceOutputWords)
+        .def("instruction_count", &PerformanceCounters::instructionCount, py::arg("operation"), py::arg("field"))
+    ;
+    py::class_<CostTerm>(m, "CostTerm")
+        .def_readonly("coefficient", &CostTerm::coefficient)
+        .def_readonly("symbols", &CostTerm::symbols)
+    ;
+    py::class_<CostExpression>(m, "CostExpression")
+        .def_readonly("terms", &CostExpression::terms)
+        .def("evaluate", &CostExpression::evaluate, py::arg("values") = std::map<string, int64_t>())
+        .def("__str__", &CostExpression::toString)
+    ;
+    py::class_<TimingBlock>(m, "TimingBlock")
+        .def_readonly("start", &TimingBlock::start)
+        .def_readonly("length", &TimingBlock::length)
+        .def_readonly("cost", &TimingBlock::cost)
+        .def_readonly("successors", &TimingBlock::successors)
+        .def_readonly("loop", &TimingBlock::loop)
+        .def_readonly("count", &TimingBlock::count)
+    ;
+    py::class_<TimingLoop>(m, "TimingLoop")
+        .def_readonly("header", &TimingLoop::header)
+        .def_readonly("latch", &TimingLoop::latch)
+        .def_readonly("parent", &TimingLoop::parent)
+        .def_readonly("counter", &TimingLoop::counter)
+        .def_readonly("iterations", &TimingLoop::iterations)
+        .def_readonly("symbol", &TimingLoop::symbol)
+        .def_readonly("blocks", &TimingLoop::blocks)
+        .def_readonly("cost", &TimingLoop::cost)
+    ;
+    py::class_<TimingAnalysis>(m, "TimingAnalysis")
+        .def_readonly("blocks", &TimingAnalysis::blocks)
+        .def_readonly("loops", &TimingAnalysis::loops)
+        .def_readonly("cost", &TimingAnalysis::cost)
+        .def("estimate", &TimingAnalysis::estimate, py::arg("iterations") = std::map<string, int64_t>())
+    ;
+    py::enum_<RegisterName>(m, "RegisterName")
+        .value("A", RegisterName::A)
+        .value("X", RegisterName::X)
+        .value("I1", RegisterName::I1)
+        .value("I2", RegisterName::I2)
+        .value("I3", RegisterName::I3)
+        .value("I4", RegisterName::I4)
+        .value("I5", RegisterName::I5)
+        .value("I6", RegisterName::I6)
+        .value("J", RegisterName::J)
+    ;
+    py::enum_<ConditionOperator>(m, "ConditionOperator")
+        .value("EQUAL", ConditionOperator::EQUAL)
+        .value("NOT_EQUAL", ConditionOperator::NOT_EQUAL)
+        .value("LESS", ConditionOperator::LESS)
+        .value("LESS_EQUAL", ConditionOperator::LESS_EQUAL)
+        .value("GREATER", ConditionOperator::GREATER)
+        .value("GREATER_EQUAL", ConditionOperator::GREATER_EQUAL)
+    ;
+    py::class_<BreakpointCondition>(m, "BreakpointCondition")
+        .def(py::init<RegisterName, ConditionOperator, int32_t>(), py::arg("reg"), py::arg("op"), py::arg("value"))
+        .def_readwrite("reg", &BreakpointCondition::reg)
+        .def_readwrite("op", &BreakpointCondition::op)
+        .def_readwrite("value", &BreakpointCondition::value)
+    ;
     py::class_<Computer>(m, "Computer")
         .def(py::init<>())
         .def_readwrite("rA", &Computer::rA)
@@ -57,7 +205,117 @@ PYBIND11_MODULE(_core, m, py::mod_gil_not_used()) {
         .def("execute_until_halt", &Computer::executeUntilHalt)
         .def("execute_until_half_or_self_loop", &Computer::executeUntilHaltOrSelfLoop)
         .def("get_device_word_at", &Computer::getDeviceWordAt, py::arg("device"), py::arg("index"), py::return_value_policy::reference_internal)
+        .def("map_device_file", &Computer::mapDeviceFile, py::arg("device"), py::arg("path"))
+        .def("unmap_device_file", &Computer::unmapDeviceFile, py::arg("device"))
+        .def("set_device_source", [](Computer& computer, const int32_t device, const py::iterable& lines) {
+            auto it = std::make_shared<py::iterator>(py::iter(lines));
+            computer.setDeviceSource(device, std::make_shared<TextBlockSource>([it](string& line) {
+                if (*it == py::iterator::sentinel()) {
+                    return false;
+                }
+                line = py::str(**it).cast<string>();
+                ++*it;
+                return true;
+            }));
+        }, py::arg("device"), py::arg("lines"))
+        .def("set_device_source_file", [](Computer& computer, const int32_t device, const string& path) {
+            auto source = std::make_shared<TextBlockSource>(std::make_unique<std::ifstream>(path));
+            computer.setDeviceSource(device, std::make_shared<AsyncBlockSource>(source));
+        }, py::arg("device"), py::arg("path"))
+        .def("set_device_sink", [](Computer& computer, const int32_t device, const py::function& callback) {
+            computer.setDeviceSink(device, std::make_shared<TextBlockSink>([callback](const string& line) {
+                callback(line);
+            }));
+        }, py::arg("device"), py::arg("callback"))
+        .def("set_device_sink_file", [](Computer& computer, const int32_t device, const string& path) {
+            auto sink = std::make_shared<TextBlockSink>(std::make_unique<std::ofstream>(path));
+            computer.setDeviceSink(device, std::make_shared<AsyncBlockSink>(sink));
+        }, py::arg("device"), py::arg("path"))
+        .def("register_device", [](Computer& computer, const int32_t device, const int32_t blockSize,
+                                   const py::object& read, const py::object& write, const py::object& control,
+                                   const double readyRate) {
+            computer.registerDevice(device, [=]() {
+                IODeviceCallback::ReadCallback onRead;
+                IODeviceCallback::WriteCallback onWrite;
+                IODeviceCallback::ControlCallback onControl;
+                if (!read.is_none()) {
+                    onRead = [read](std::span<ComputerWord> block) {
+                        const py::object values = read();
+                        if (values.is_none() || (py::isinstance<py::bool_>(values) && !values.cast<bool>())) {
+                            return false;
+                        }
+                        size_t index = 0;
+                        for (const auto& value : values) {
+                            if (index >= block.size()) {
+                                break;
+                            }
+                            block[index++].set(value.cast<int32_t>());
+                        }
+                        return true;
+                    };
+                }
+                if (!write.is_none()) {
+                    onWrite = [write](std::span<const ComputerWord> block) {
+                        py::list values;
+                        for (const auto& word : block) {
+                            values.append(word.value());
+                        }
+                        write(values);
+                    };
+                }
+                if (!control.is_none()) {
+                    onControl = [control](const int32_t operation) { control(operation); };
+                }
+                return std::make_unique<IODeviceCallback>(blockSize, onRead, onWrite, onControl, readyRate);
+            });
+        }, py::arg("device"), py::arg("block_size"), py::arg("read") = py::none(), py::arg("write") = py::none(),
+           py::arg("control") = py::none(), py::arg("ready_rate") = 1.0)
+        .def("unregister_device", [](Computer& computer, const int32_t device) {
+            computer.registerDevice(device, nullptr);
+        }, py::arg("device"))
+        .def("has_registered_device", &Computer::hasRegisteredDevice, py::arg("device"))
+        .def("set_breakpoint", py::overload_cast<int32_t>(&Computer::setBreakpoint), py::arg("address"))
+        .def("set_breakpoint", py::overload_cast<int32_t, const BreakpointCondition&>(&Computer::setBreakpoint), py::arg("address"), py::arg("condition"))
+        .def("clear_breakpoint", &Computer::clearBreakpoint, py::arg("address"))
+        .def("clear_breakpoints", &Computer::clearBreakpoints)
+        .def("has_breakpoint", &Computer::hasBreakpoint, py::arg("address"))
+        .def("set_watchpoint", &Computer::setWatchpoint, py::arg("address"), py::arg("on_read") = false, py::arg("on_write") = true)
+        .def("clear_watchpoint", &Computer::clearWatchpoint, py::arg("address"))
+        .def("clear_watchpoints", &Computer::clearWatchpoints)
+        .def("set_resource_limits", &Computer::setResourceLimits, py::arg("limits"))
+        .def("clear_resource_limits", &Computer::clearResourceLimits)
+        .def("resource_limits", &Computer::resourceLimits)
+        .def("resource_usage", &Computer::resourceUsage)
+        .def("set_loop_detection", &Computer::setLoopDetection, py::arg("enabled"))
+        .def("loop_detection", &Computer::loopDetection)
+        .def("set_idle_fast_forward", &Computer::setIdleFastForward, py::arg("enabled"))
+        .def("idle_fast_forward", &Computer::idleFastForward)
+        .def("set_interrupt_vector", &Computer::setInterruptVector, py::arg("address"))
+        .def("interrupt_vector", &Computer::interruptVector)
+        .def("in_control_state", &Computer::inControlState)
+        .def("run", &Computer::run, py::arg("max_steps") = -1, py::arg("max_elapsed") = -1)
+        .def("run_until_break", &Computer::runUntilBreak)
         .def("line", &Computer::line)
         .def("elapsed", &Computer::elapsed)
+        .def("steps", &Computer::steps)
+        .def("set_counters_enabled", &Computer::setCountersEnabled, py::arg("enabled"))
+        .def("counters_enabled", &Computer::countersEnabled)
+        .def("performance_counters", &Computer::performanceCounters)
+        .def("reset_performance_counters", &Computer::resetPerformanceCounters)
+        .def("set_device_trace_capacity", &Computer::setDeviceTraceCapacity, py::arg("capacity"))
+        .def("clear_device_trace", &Computer::clearDeviceTrace)
+        .def("device_trace_json", [](const Computer& computer) {
+            return computer.deviceTrace().toChromeTrace();
+        })
+        .def("write_device_trace", [](const Computer& computer, const string& path) {
+            std::ofstream out(path);
+            computer.deviceTrace().writeChromeTrace(out);
+        }, py::arg("path"))
+        .def("translate_to_cpp", [](const Computer& computer, int32_t entry, const string& functionName) {
+            TranslationOptions options;
+            options.functionName = functionName;
+            return translateToCpp(computer, entry, options);
+        }, py::arg("entry"), py::arg("function_name") = "mixal_translated")
+        .def("analyze_timing", &analyzeTiming, py::arg("entry"))
     ;
 }
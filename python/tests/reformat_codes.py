@@ -1,10 +1,9 @@
 import re
 import sys
 
-from src.generate_get_instruction import OPS
-
 file_path = sys.argv[1]
-ops = set(OPS)
+with open("include/instructions.h") as reader:
+    ops = set(re.findall(r'^    \{"(\w+)",', reader.read(), re.MULTILINE))
 
 with open(file_path) as reader:
     lines = []
@@ -1,4 +1,17 @@
-from ._core import Computer, ComputerWord, Register2
+from ._core import (
+    BreakpointCondition,
+    ComputerWord,
+    ConditionOperator,
+    Computer,
+    PerformanceCounters,
+    Register2,
+    RegisterName,
+    ResourceKind,
+    ResourceLimits,
+    ResourceUsage,
+    StopInfo,
+    StopReason,
+)
 
 Register5 = ComputerWord
 
@@ -7,4 +20,13 @@ __all__ = [
     "Register5",
     "Register2",
     "Computer",
+    "StopReason",
+    "StopInfo",
+    "RegisterName",
+    "ConditionOperator",
+    "BreakpointCondition",
+    "ResourceKind",
+    "ResourceLimits",
+    "ResourceUsage",
+    "PerformanceCounters",
 ]
@@ -6,7 +6,7 @@ namespace mixal {
 Atomic::Atomic(const AtomicType _type, const bool _negative) :
         type(_type), negative(_negative), integer() {}
 
-Atomic::Atomic(const AtomicType _type, const int32_t _value, const bool _negative) :
+Atomic::Atomic(const AtomicType _type, const WordValue _value, const bool _negative) :
     type(_type), negative(_negative), integer(_value) {}
 
 Atomic::Atomic(const AtomicType _type, const std::string& _value, const bool _negative) :
@@ -55,7 +55,7 @@ void Atomic::replaceSymbol(const std::string& _symbol) {
 
 AtomicValue::AtomicValue() : negative(), value() {}
 
-AtomicValue::AtomicValue(const int32_t _value) : negative(), value(_value) {
+AtomicValue::AtomicValue(const WordValue _value) : negative(), value(_value) {
     negative = _value < 0;
 }
 
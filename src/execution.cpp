@@ -0,0 +1,58 @@
+#include "execution.h"
+
+namespace mixal {
+
+namespace {
+
+std::string resourceName(const ResourceKind resource) {
+    switch (resource) {
+    case ResourceKind::NONE: return "none";
+    case ResourceKind::PRINTED_LINES: return "printed lines";
+    case ResourceKind::PUNCHED_CARDS: return "punched cards";
+    case ResourceKind::TAPE_BLOCKS: return "tape blocks";
+    case ResourceKind::DISK_BLOCKS: return "disk blocks";
+    case ResourceKind::MOVED_WORDS: return "moved words";
+    case ResourceKind::ELAPSED: return "elapsed time";
+    case ResourceKind::WALL_CLOCK: return "wall clock";
+    }
+    return "";
+}
+
+}  // namespace
+
+std::string Fault::message() const {
+    switch (code) {
+    case FaultCode::NONE:
+        return "";
+    case FaultCode::INVALID_LINE:
+        return "Invalid code line: " + std::to_string(operand);
+    case FaultCode::INVALID_INDEX:
+        return "Invalid offset for index register: " + std::to_string(operand);
+    case FaultCode::INVALID_ADDRESS:
+        return "Invalid address in instruction '" + instruction.getBytesString() + "': " + std::to_string(operand);
+    case FaultCode::INVALID_FIELD:
+        return "Invalid field value: (" + std::to_string(operand / 8) + ":" + std::to_string(operand % 8) + ")";
+    case FaultCode::DIVISION_BY_ZERO:
+        return "Divisor cannot be 0";
+    case FaultCode::FLOAT_DIVISION_BY_ZERO:
+        return "Floating-point divisor cannot be 0";
+    case FaultCode::INT_OUTSIDE_HANDLER:
+        return "INT can only be used in an interrupt handler";
+    case FaultCode::READ_NOT_SUPPORTED:
+        return "Device does not support read: " + std::to_string(operand);
+    case FaultCode::WRITE_NOT_SUPPORTED:
+        return "Device does not support write: " + std::to_string(operand);
+    case FaultCode::BLOCK_OUT_OF_MEMORY:
+        return "Block of instruction '" + instruction.getBytesString() + "' exceeds the memory: " +
+               std::to_string(operand) + " + " + std::to_string(blockSize);
+    case FaultCode::RESOURCE_LIMIT:
+        return "Resource limit exceeded: " + resourceName(static_cast<ResourceKind>(operand));
+    case FaultCode::INVALID_DEVICE:
+        return "Invalid device: " + std::to_string(operand);
+    case FaultCode::NULL_DEVICE:
+        return "The device factory returns null: " + std::to_string(operand);
+    }
+    return "";
+}
+
+}  // namespace mixal
@@ -35,7 +35,7 @@ Expression Expression::getConstExpression(const std::string& symbol) {
 
 Expression Expression::getConstOffsetExpression(const std::string& symbol, int32_t offset) {
     auto expr = Expression();
-    expr._atomics = {Atomic(AtomicType::SYMBOL, symbol), Atomic(AtomicType::INTEGER, offset)};
+    expr._atomics = {Atomic(AtomicType::SYMBOL, symbol), Atomic(AtomicType::INTEGER, static_cast<WordValue>(offset))};
     expr._operations = {Operation::ADD};
     expr._depends.insert(symbol);
     return expr;
@@ -150,7 +150,7 @@ void Expression::parse(const std::string& expression, const std::string& lineSym
                         "Invalid character found while trying to find an operation: " + std::string(1, ch));
                 }
                 bool isInteger = true, negative = false;
-                int32_t integerValue = 0;
+                WordValue integerValue = 0;
                 if (expression[lastAtomicStart] == '-') {
                     negative = true;
                     ++lastAtomicStart;
@@ -168,7 +168,7 @@ void Expression::parse(const std::string& expression, const std::string& lineSym
                         break;
                     }
                     const int32_t digit = expression[j] - '0';
-                    if (integerValue > (std::numeric_limits<int32_t>::max() - digit) / 10) {
+                    if (integerValue > (std::numeric_limits<WordValue>::max() - digit) / 10) {
                         throw ExpressionError(i, "The integer value is too large: " +
                             expression.substr(lastAtomicStart, i - lastAtomicStart));
                     }
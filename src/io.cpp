@@ -2,67 +2,247 @@
 #include <cstdlib>
 #include <cmath>
 #include <algorithm>
-#include <sstream>
+#include <stdexcept>
 #include "io.h"
 
 namespace mixal {
 
+PagedStorage::PagedStorage(const int32_t size) : _size(size), _pages() {}
+
+PagedStorage::PagedStorage(const PagedStorage& other) : _size(other._size), _pages(other._pages.size()) {
+    for (size_t i = 0; i < other._pages.size(); ++i) {
+        if (other._pages[i] != nullptr) {
+            _pages[i] = std::make_unique<Page>(*other._pages[i]);
+        }
+    }
+}
+
+PagedStorage& PagedStorage::operator=(const PagedStorage& other) {
+    if (this != &other) {
+        *this = PagedStorage(other);
+    }
+    return *this;
+}
+
+int32_t PagedStorage::numAllocatedPages() const {
+    return static_cast<int32_t>(std::count_if(_pages.begin(), _pages.end(),
+                                              [](const auto& page) { return page != nullptr; }));
+}
+
+const ComputerWord& PagedStorage::get(const int32_t index) const {
+    static const ComputerWord ZERO;
+    const auto pageIndex = static_cast<size_t>(index / PAGE_SIZE);
+    if (index < 0 || pageIndex >= _pages.size() || _pages[pageIndex] == nullptr) {
+        return ZERO;
+    }
+    return (*_pages[pageIndex])[index % PAGE_SIZE];
+}
+
+ComputerWord& PagedStorage::at(const int32_t index) {
+    if (index < 0) {
+        throw std::out_of_range("Invalid location of device storage: " + std::to_string(index));
+    }
+    const auto pageIndex = static_cast<size_t>(index / PAGE_SIZE);
+    if (pageIndex >= _pages.size()) {
+        _pages.resize(pageIndex + 1);
+    }
+    if (_pages[pageIndex] == nullptr) {
+        _pages[pageIndex] = std::make_unique<Page>();
+    }
+    _size = std::max(_size, index + 1);
+    return (*_pages[pageIndex])[index % PAGE_SIZE];
+}
+
+void PagedStorage::load(int32_t index, ComputerWord* words, int32_t count) const {
+    if (index < 0) {
+        const int32_t skipped = std::min(count, -index);
+        std::fill_n(words, skipped, ComputerWord());
+        index += skipped;
+        words += skipped;
+        count -= skipped;
+    }
+    while (count > 0) {
+        const auto pageIndex = static_cast<size_t>(index / PAGE_SIZE);
+        const int32_t offset = index % PAGE_SIZE;
+        const int32_t length = std::min(count, PAGE_SIZE - offset);
+        if (pageIndex < _pages.size() && _pages[pageIndex] != nullptr) {
+            std::copy_n(_pages[pageIndex]->begin() + offset, length, words);
+        } else {
+            std::fill_n(words, length, ComputerWord());
+        }
+        index += length;
+        words += length;
+        count -= length;
+    }
+}
+
+void PagedStorage::store(int32_t index, const ComputerWord* words, int32_t count) {
+    while (count > 0) {
+        const int32_t length = std::min(count, PAGE_SIZE - index % PAGE_SIZE);
+        std::copy_n(words, length, &at(index));
+        _size = std::max(_size, index + length);
+        index += length;
+        words += length;
+        count -= length;
+    }
+}
+
+void PagedStorage::clear(const int32_t size) {
+    _size = size;
+    _pages.clear();
+}
+
 IODevice::IODevice(const int32_t blockSize, const bool allowRead, const bool allowWrite) : _type(IODeviceType::TAPE),
         _blockSize(blockSize), _allowRead(allowRead), _allowWrite(allowWrite),
         _timestamp(), _readyRate(1.0) {}
 
-bool IODevice::ready(const int32_t timestamp) {
-    const int32_t elapsed = std::max(0, timestamp - _timestamp);
+bool IODevice::ready(const int64_t timestamp) {
+    const int64_t elapsed = std::max<int64_t>(0, timestamp - _timestamp);
     _timestamp = timestamp;
     const double r = static_cast<double>(rand()) / RAND_MAX;
-    const double successRate = 1.0 - pow(1.0 - _readyRate, elapsed);
+    const double successRate = 1.0 - pow(1.0 - _readyRate, static_cast<double>(elapsed));
     return r <= successRate;
 }
 
+int64_t IODevice::pollUntilReady(int64_t timestamp, const int64_t interval, const int64_t limit) {
+    while (timestamp < limit && !ready(timestamp)) {
+        timestamp += interval;
+    }
+    return timestamp;
+}
+
+void IODevice::reset() {
+    _timestamp = 0;
+}
+
 IODeviceStorage::IODeviceStorage(const int32_t storageSize) : IODevice(100, true, true),
-        _status(IODeviceStatus::READY), _address(0), _locator(0), _memory(nullptr),
-        _buffer(100), _storage(storageSize) {}
+        _status(IODeviceStatus::READY), _address(0), _locator(0), _storageSize(storageSize), _memory(nullptr),
+        _buffer(), _storage(storageSize) {}
 
-bool IODeviceStorage::ready(const int32_t elapsed) {
+bool IODeviceStorage::ready(const int64_t elapsed) {
     bool state = IODevice::ready(elapsed);
     if (state) {
-        if (_status == IODeviceStatus::BUSY_READ) {
-            doRead();
-        } else if (_status == IODeviceStatus::BUSY_WRITE) {
-            doWrite();
-        }
+        finish();
     }
     return state;
 }
 
+/** The number of failed queries follows a geometric distribution,
+ * so it is sampled with one random number and the result has the same distribution as querying one by one.
+ */
+int64_t IODeviceStorage::pollUntilReady(const int64_t timestamp, const int64_t interval, const int64_t limit) {
+    if (_status == IODeviceStatus::READY && timestamp < limit) {
+        _timestamp = timestamp;
+        return timestamp;
+    }
+    const double failureRate = pow(1.0 - _readyRate, static_cast<double>(interval));
+    if (failureRate >= 1.0 || interval <= 0 || timestamp >= limit) {
+        return IODevice::pollUntilReady(timestamp, interval, limit);
+    }
+    if (ready(timestamp)) {
+        return timestamp;
+    }
+    // The queries are independent, so the ones stopped by the limit can be sampled again later.
+    const int64_t maxFailures = (limit - timestamp - 1) / interval;
+    int64_t failures = 0;
+    if (failureRate > 0.0) {
+        const double r = (static_cast<double>(rand()) + 1.0) / (static_cast<double>(RAND_MAX) + 1.0);
+        failures = static_cast<int64_t>(std::min(std::floor(std::log(r) / std::log(failureRate)),
+                                                 static_cast<double>(maxFailures)));
+    }
+    if (failures >= maxFailures) {
+        _timestamp = timestamp + maxFailures * interval;
+        return _timestamp + interval;
+    }
+    const int64_t readyTime = timestamp + (failures + 1) * interval;
+    _timestamp = readyTime;
+    finish();
+    return readyTime;
+}
+
+void IODeviceStorage::finish() {
+    if (_status == IODeviceStatus::BUSY_READ) {
+        doRead();
+    } else if (_status == IODeviceStatus::BUSY_WRITE) {
+        doWrite();
+    }
+}
+
+void IODeviceStorage::reset() {
+    IODevice::reset();
+    _status = IODeviceStatus::READY;
+    _address = 0;
+    _locator = 0;
+    _memory = nullptr;
+    _storage.clear(_storageSize);
+    _mapped.reset();
+}
+
+ComputerWord& IODeviceStorage::wordAt(const int32_t index) {
+    if (_mapped != nullptr) {
+        throw std::logic_error("The storage is mapped to a file: " + _mapped->path());
+    }
+    return _storage.at(index);
+}
+
+void IODeviceStorage::mapFile(const std::string& path) {
+    _mapped = std::make_shared<MappedStorage>(path);
+    _storage.clear(0);
+}
+
+void IODeviceStorage::unmapFile() {
+    if (_mapped != nullptr) {
+        _mapped->flush();
+        _mapped.reset();
+    }
+}
+
+int32_t IODeviceStorage::storageSize() const {
+    return _mapped != nullptr ? _mapped->size() : _storage.size();
+}
+
+ComputerWord IODeviceStorage::loadWord(const int32_t index) const {
+    return _mapped != nullptr ? _mapped->get(index) : _storage.get(index);
+}
+
+void IODeviceStorage::storeWord(const int32_t index, const ComputerWord& word) {
+    if (_mapped != nullptr) {
+        _mapped->set(index, word);
+    } else {
+        _storage.at(index) = word;
+    }
+}
+
 void IODeviceStorage::read(ComputerWord* memory, const int32_t address) {
     _status = IODeviceStatus::BUSY_READ;
     _address = address;
     _memory = memory;
-    for (int i = 0; i < _blockSize; ++i) {
-        _buffer[i] = _storage[_locator + i];
+    _buffer.resize(_blockSize);
+    if (_mapped != nullptr) {
+        _mapped->load(_locator, _buffer.data(), _blockSize);
+    } else {
+        _storage.load(_locator, _buffer.data(), _blockSize);
     }
     ready(_timestamp);
 }
 
 void IODeviceStorage::write(const ComputerWord* memory, int32_t address) {
     _status = IODeviceStatus::BUSY_WRITE;
-    for (int i = 0; i < _blockSize; ++i) {
-        _buffer[i] = memory[address + i];
-    }
+    _buffer.resize(_blockSize);
+    std::copy_n(memory + address, _blockSize, _buffer.begin());
     ready(_timestamp);
 }
 
 void IODeviceStorage::doRead() {
-    for (int i = 0; i < _blockSize; ++i) {
-        _memory[_address + i] = _buffer[i];
-    }
+    std::copy_n(_buffer.begin(), _blockSize, _memory + _address);
     _status = IODeviceStatus::READY;
 }
 
 void IODeviceStorage::doWrite() {
-    for (int i = 0; i < _blockSize; ++i) {
-        _storage[_locator + i] = _buffer[i];
+    if (_mapped != nullptr) {
+        _mapped->store(_locator, _buffer.data(), _blockSize);
+    } else {
+        _storage.store(_locator, _buffer.data(), _blockSize);
     }
     _status = IODeviceStatus::READY;
 }
@@ -100,21 +280,90 @@ void IODeviceDisk::control(const int32_t operation) {
     _locator = operation;
 }
 
-IODeviceSeqReader::IODeviceSeqReader(const int32_t storageSize) : IODeviceStorage(storageSize) {
+IODeviceSeqReader::IODeviceSeqReader(const int32_t storageSize) : IODeviceStorage(storageSize),
+        _source(), _nextBlock(), _hasNextBlock(false) {
     _allowWrite = false;
 }
 
+bool IODeviceSeqReader::exhausted() const {
+    if (_source != nullptr) {
+        return !_hasNextBlock;
+    }
+    int32_t locator = _locator;
+    if (_status == IODeviceStatus::BUSY_READ) {
+        locator += _blockSize;
+    }
+    return locator + _blockSize > storageSize();
+}
+
+void IODeviceSeqReader::reset() {
+    IODeviceStorage::reset();
+    _source.reset();
+    _hasNextBlock = false;
+}
+
+void IODeviceSeqReader::setSource(std::shared_ptr<BlockSource> source) {
+    _source = std::move(source);
+    _hasNextBlock = false;
+    if (_source != nullptr) {
+        fetchNextBlock();
+    }
+}
+
+void IODeviceSeqReader::fetchNextBlock() {
+    _nextBlock.assign(_blockSize, ComputerWord());
+    _hasNextBlock = _source->next(_nextBlock.data(), _blockSize);
+}
+
+/** Take the block fetched ahead from the source, zeros are read if the source has ended. */
+void IODeviceSeqReader::read(ComputerWord* memory, const int32_t address) {
+    if (_source == nullptr) {
+        IODeviceStorage::read(memory, address);
+        return;
+    }
+    _status = IODeviceStatus::BUSY_READ;
+    _address = address;
+    _memory = memory;
+    if (_hasNextBlock) {
+        _buffer.swap(_nextBlock);
+        fetchNextBlock();
+    } else {
+        _buffer.assign(_blockSize, ComputerWord());
+    }
+    ready(_timestamp);
+}
+
 void IODeviceSeqReader::doRead() {
     IODeviceStorage::doRead();
     _locator += _blockSize;
 }
 
-IODeviceSeqWriter::IODeviceSeqWriter(const int32_t storageSize) : IODeviceStorage(storageSize) {
+IODeviceSeqWriter::IODeviceSeqWriter(const int32_t storageSize) : IODeviceStorage(storageSize), _sink() {
     _allowRead = false;
 }
 
+void IODeviceSeqWriter::reset() {
+    IODeviceStorage::reset();
+    _sink.reset();
+}
+
+void IODeviceSeqWriter::flush() {
+    if (_sink != nullptr) {
+        _sink->flush();
+    }
+}
+
+void IODeviceSeqWriter::setSink(std::shared_ptr<BlockSink> sink) {
+    _sink = std::move(sink);
+}
+
 void IODeviceSeqWriter::doWrite() {
-    IODeviceStorage::doWrite();
+    if (_sink != nullptr) {
+        _sink->put(_buffer.data(), _blockSize);
+        _status = IODeviceStatus::READY;
+    } else {
+        IODeviceStorage::doWrite();
+    }
     _locator += _blockSize;
 }
 
@@ -145,11 +394,35 @@ void IODeviceLinePrinter::control(int32_t) {
 
 std::string IODeviceLinePrinter::line(const int32_t pageNum, const int32_t lineNum) const {
     const int32_t offset = pageNum * NUM_WORDS_PER_LINE * _numLinesPerPage + lineNum * NUM_WORDS_PER_LINE;
-    std::ostringstream out;
-    for (int i = 0; i < NUM_WORDS_PER_LINE; ++i) {
-        out << _storage[offset + i].getCharacters();
+    std::array<ComputerWord, NUM_WORDS_PER_LINE> words;
+    if (_mapped != nullptr) {
+        _mapped->load(offset, words.data(), NUM_WORDS_PER_LINE);
+    } else {
+        for (int i = 0; i < NUM_WORDS_PER_LINE; ++i) {
+            words[i] = _storage.get(offset + i);
+        }
     }
-    return out.str();
+    return wordsToText(words.data(), NUM_WORDS_PER_LINE);
+}
+
+std::string IODeviceLinePrinter::page(const int32_t pageNum) const {
+    const int32_t numWords = NUM_WORDS_PER_LINE * _numLinesPerPage;
+    const int32_t offset = pageNum * numWords;
+    std::vector<ComputerWord> words(numWords);
+    if (_mapped != nullptr) {
+        _mapped->load(offset, words.data(), numWords);
+    } else {
+        for (int32_t i = 0; i < numWords; ++i) {
+            words[i] = _storage.get(offset + i);
+        }
+    }
+    std::string result;
+    result.reserve(static_cast<size_t>(NUM_CHARACTERS_PER_LINE + 1) * _numLinesPerPage);
+    for (int32_t i = 0; i < _numLinesPerPage; ++i) {
+        result += wordsToText(words.data() + i * NUM_WORDS_PER_LINE, NUM_WORDS_PER_LINE);
+        result += '\n';
+    }
+    return result;
 }
 
 IODeviceTypewriter::IODeviceTypewriter(const int32_t storageSize) : IODeviceStorage(storageSize) {
@@ -168,4 +441,43 @@ void IODevicePaperTape::control(int32_t) {
     _locator = 0;
 }
 
+IODeviceCallback::IODeviceCallback(const int32_t blockSize, ReadCallback onRead, WriteCallback onWrite,
+                                   ControlCallback onControl, const double readyRate) :
+        IODeviceStorage(0), _onRead(std::move(onRead)), _onWrite(std::move(onWrite)),
+        _onControl(std::move(onControl)), _exhausted(false) {
+    _type = IODeviceType::CUSTOM;
+    _blockSize = blockSize;
+    _allowRead = _onRead != nullptr;
+    _allowWrite = _onWrite != nullptr;
+    _readyRate = readyRate;
+}
+
+void IODeviceCallback::control(const int32_t operation) {
+    if (_onControl != nullptr) {
+        _onControl(operation);
+    }
+}
+
+void IODeviceCallback::reset() {
+    IODeviceStorage::reset();
+    _exhausted = false;
+}
+
+void IODeviceCallback::read(ComputerWord* memory, const int32_t address) {
+    _status = IODeviceStatus::BUSY_READ;
+    _address = address;
+    _memory = memory;
+    _buffer.assign(_blockSize, ComputerWord());
+    if (!_exhausted && !_onRead(std::span<ComputerWord>(_buffer))) {
+        _exhausted = true;
+        _buffer.assign(_blockSize, ComputerWord());
+    }
+    ready(_timestamp);
+}
+
+void IODeviceCallback::doWrite() {
+    _onWrite(std::span<const ComputerWord>(_buffer));
+    _status = IODeviceStatus::READY;
+}
+
 }  // namespace mixal
@@ -0,0 +1,149 @@
+#include <algorithm>
+#include <stdexcept>
+#include "io.h"
+
+/**
+ * @file
+ * @brief Host reading and writing on background threads.
+ */
+
+namespace mixal {
+
+AsyncBlockSource::AsyncBlockSource(std::shared_ptr<BlockSource> source, const int32_t depth) :
+    _source(std::move(source)), _depth(std::max(1, depth)), _blockSize(-1), _blocks(),
+    _finished(false), _stopping(false), _error(), _mutex(), _fetched(), _consumed(), _worker() {}
+
+AsyncBlockSource::~AsyncBlockSource() {
+    {
+        std::lock_guard lock(_mutex);
+        _stopping = true;
+    }
+    _consumed.notify_all();
+    if (_worker.joinable()) {
+        _worker.join();
+    }
+}
+
+bool AsyncBlockSource::next(ComputerWord* words, const int32_t count) {
+    std::unique_lock lock(_mutex);
+    if (_blockSize == -1) {
+        _blockSize = count;
+        _worker = std::thread(&AsyncBlockSource::work, this);
+    } else if (_blockSize != count) {
+        throw std::logic_error("Inconsistent block size: " + std::to_string(count));
+    }
+    _fetched.wait(lock, [this] { return !_blocks.empty() || _finished; });
+    if (_blocks.empty()) {
+        if (_error != nullptr) {
+            const auto error = _error;
+            _error = nullptr;
+            std::rethrow_exception(error);
+        }
+        return false;
+    }
+    std::copy(_blocks.front().begin(), _blocks.front().end(), words);
+    _blocks.pop_front();
+    lock.unlock();
+    _consumed.notify_one();
+    return true;
+}
+
+void AsyncBlockSource::work() {
+    while (true) {
+        {
+            std::unique_lock lock(_mutex);
+            _consumed.wait(lock, [this] { return _stopping || static_cast<int32_t>(_blocks.size()) < _depth; });
+            if (_stopping) {
+                return;
+            }
+        }
+        std::vector<ComputerWord> block(_blockSize);
+        bool hasBlock = false;
+        std::exception_ptr error;
+        try {
+            hasBlock = _source->next(block.data(), _blockSize);
+        } catch (...) {
+            error = std::current_exception();
+        }
+        {
+            std::lock_guard lock(_mutex);
+            if (hasBlock) {
+                _blocks.push_back(std::move(block));
+            } else {
+                _finished = true;
+                _error = error;
+            }
+        }
+        _fetched.notify_one();
+        if (!hasBlock) {
+            return;
+        }
+    }
+}
+
+AsyncBlockSink::AsyncBlockSink(std::shared_ptr<BlockSink> sink) :
+    _sink(std::move(sink)), _blocks(), _busy(false), _stopping(false), _error(),
+    _mutex(), _queued(), _drained(), _worker(&AsyncBlockSink::work, this) {}
+
+AsyncBlockSink::~AsyncBlockSink() {
+    {
+        std::lock_guard lock(_mutex);
+        _stopping = true;
+    }
+    _queued.notify_all();
+    _worker.join();
+}
+
+void AsyncBlockSink::put(const ComputerWord* words, const int32_t count) {
+    {
+        std::lock_guard lock(_mutex);
+        rethrow();
+        _blocks.emplace_back(words, words + count);
+    }
+    _queued.notify_one();
+}
+
+void AsyncBlockSink::flush() {
+    std::unique_lock lock(_mutex);
+    _drained.wait(lock, [this] { return _blocks.empty() && !_busy; });
+    rethrow();
+    _sink->flush();
+}
+
+/** Raise the error of the inner sink only once, the caller should hold the lock. */
+void AsyncBlockSink::rethrow() {
+    if (_error != nullptr) {
+        const auto error = _error;
+        _error = nullptr;
+        std::rethrow_exception(error);
+    }
+}
+
+/** Pass the queued blocks until stopped, the remaining blocks are passed before exiting. */
+void AsyncBlockSink::work() {
+    std::unique_lock lock(_mutex);
+    while (true) {
+        _queued.wait(lock, [this] { return _stopping || !_blocks.empty(); });
+        if (_blocks.empty()) {
+            return;
+        }
+        auto block = std::move(_blocks.front());
+        _blocks.pop_front();
+        _busy = true;
+        lock.unlock();
+        try {
+            _sink->put(block.data(), static_cast<int32_t>(block.size()));
+        } catch (...) {
+            lock.lock();
+            _error = std::current_exception();
+            lock.unlock();
+        }
+        lock.lock();
+        _busy = false;
+        if (_blocks.empty()) {
+            _drained.notify_all();
+        }
+    }
+}
+
+}  // namespace mixal
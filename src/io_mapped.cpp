@@ -0,0 +1,217 @@
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include "io.h"
+
+#if defined(_WIN32)
+#define MIXAL_NO_MMAP
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/**
+ * @file
+ * @brief Device storage mapped to files.
+ */
+
+namespace mixal {
+
+namespace {
+
+/** The number of words that the file is extended at least. */
+constexpr int32_t MIN_GROWTH = 4096;
+/** The number of words that the host is asked to read ahead. */
+constexpr int32_t PREFETCH_WORDS = 65536;
+
+std::runtime_error systemError(const std::string& message, const std::string& path) {
+    return std::runtime_error(message + ": " + path + ": " + std::strerror(errno));
+}
+
+}  // namespace
+
+uint64_t MappedStorage::encode(const ComputerWord& word) {
+    constexpr uint64_t MASK = (uint64_t{1} << BYTE_BITS) - 1;
+    return (word.negative ? uint64_t{1} << (5 * BYTE_BITS) : 0u) |
+           (word.byte1 & MASK) << (4 * BYTE_BITS) |
+           (word.byte2 & MASK) << (3 * BYTE_BITS) |
+           (word.byte3 & MASK) << (2 * BYTE_BITS) |
+           (word.byte4 & MASK) << BYTE_BITS |
+           (word.byte5 & MASK);
+}
+
+ComputerWord MappedStorage::decode(const uint64_t code) {
+    constexpr uint64_t MASK = (uint64_t{1} << BYTE_BITS) - 1;
+    return {(code >> (5 * BYTE_BITS) & 1) != 0,
+            static_cast<uint8_t>(code >> (4 * BYTE_BITS) & MASK),
+            static_cast<uint8_t>(code >> (3 * BYTE_BITS) & MASK),
+            static_cast<uint8_t>(code >> (2 * BYTE_BITS) & MASK),
+            static_cast<uint8_t>(code >> BYTE_BITS & MASK),
+            static_cast<uint8_t>(code & MASK)};
+}
+
+#ifdef MIXAL_NO_MMAP
+
+MappedStorage::MappedStorage(const std::string& path) :
+        _path(path), _fd(-1), _data(nullptr), _size(0), _capacity(0), _prefetched(0) {
+    throw std::runtime_error("Memory-mapped files are not supported on this platform: " + path);
+}
+
+MappedStorage::~MappedStorage() = default;
+
+void MappedStorage::grow(int32_t) {}
+
+bool MappedStorage::map(int32_t) { return false; }
+
+void MappedStorage::unmap() {}
+
+void MappedStorage::flush() {}
+
+void MappedStorage::prefetch(int32_t, int32_t) {}
+
+#else
+
+MappedStorage::MappedStorage(const std::string& path) :
+        _path(path), _fd(-1), _data(nullptr), _size(0), _capacity(0), _prefetched(0) {
+    _fd = open(path.c_str(), O_RDWR | O_CREAT, 0644);
+    if (_fd < 0) {
+        throw systemError("Cannot open the device file", path);
+    }
+    struct stat info{};
+    if (fstat(_fd, &info) != 0) {
+        close(_fd);
+        throw systemError("Cannot get the size of the device file", path);
+    }
+    const auto numWords = static_cast<int64_t>(info.st_size) / WORD_BYTES;
+    if (numWords > INT32_MAX) {
+        close(_fd);
+        throw std::runtime_error("The device file is too large: " + path);
+    }
+    if (numWords > 0) {
+        if (!map(static_cast<int32_t>(numWords))) {
+            close(_fd);
+            throw systemError("Cannot map the device file", path);
+        }
+        _size = _capacity;
+        madvise(_data, static_cast<size_t>(_capacity) * WORD_BYTES, MADV_SEQUENTIAL);
+    }
+}
+
+/** The space reserved by `grow` is removed, so the file only holds the written words. */
+MappedStorage::~MappedStorage() {
+    unmap();
+    // If it fails, the file keeps the reserved zeros, which are read back as zeros.
+    [[maybe_unused]] const int truncated = ftruncate(_fd, static_cast<off_t>(_size) * WORD_BYTES);
+    close(_fd);
+}
+
+bool MappedStorage::map(const int32_t capacity) {
+    void* data = mmap(nullptr, static_cast<size_t>(capacity) * WORD_BYTES, PROT_READ | PROT_WRITE, MAP_SHARED, _fd, 0);
+    if (data == MAP_FAILED) {
+        _size = 0;
+        return false;
+    }
+    _data = static_cast<uint8_t*>(data);
+    _capacity = capacity;
+    _prefetched = 0;
+    return true;
+}
+
+void MappedStorage::unmap() {
+    if (_data != nullptr) {
+        msync(_data, static_cast<size_t>(_capacity) * WORD_BYTES, MS_ASYNC);
+        munmap(_data, static_cast<size_t>(_capacity) * WORD_BYTES);
+        _data = nullptr;
+        _capacity = 0;
+    }
+}
+
+void MappedStorage::flush() {
+    if (_data != nullptr) {
+        msync(_data, static_cast<size_t>(_capacity) * WORD_BYTES, MS_SYNC);
+    }
+}
+
+/** Issue a read-ahead for the next window once the accesses reach the middle of the current one. */
+void MappedStorage::prefetch(const int32_t index, const int32_t count) {
+    if (_data == nullptr || index + count + PREFETCH_WORDS / 2 < _prefetched) {
+        return;
+    }
+    static const auto pageSize = static_cast<int64_t>(sysconf(_SC_PAGESIZE));
+    const int64_t start = std::max<int64_t>(_prefetched, index) * WORD_BYTES / pageSize * pageSize;
+    const int64_t end = std::min<int64_t>(static_cast<int64_t>(_size), static_cast<int64_t>(index) + PREFETCH_WORDS) *
+                        WORD_BYTES;
+    if (start < end) {
+        madvise(_data + start, static_cast<size_t>(end - start), MADV_WILLNEED);
+    }
+    _prefetched = static_cast<int32_t>(end / WORD_BYTES);
+}
+
+/** The capacity is at least doubled so that sequential writes are amortized.
+ *
+ * The old region is mapped again if the file cannot be extended. If no region can be mapped,
+ * the storage becomes empty so that it is never accessed through a null pointer.
+ */
+void MappedStorage::grow(const int32_t size) {
+    const int32_t oldCapacity = _capacity;
+    const auto newCapacity = static_cast<int32_t>(std::min<int64_t>(
+        INT32_MAX, std::max<int64_t>({size, static_cast<int64_t>(_capacity) * 2, MIN_GROWTH})));
+    unmap();
+    if (ftruncate(_fd, static_cast<off_t>(newCapacity) * WORD_BYTES) != 0) {
+        const auto error = systemError("Cannot extend the device file", _path);
+        if (oldCapacity == 0 || !map(oldCapacity)) {
+            _size = 0;
+        }
+        throw error;
+    }
+    if (!map(newCapacity)) {
+        throw systemError("Cannot map the device file", _path);
+    }
+}
+
+#endif
+
+ComputerWord MappedStorage::get(const int32_t index) const {
+    if (index < 0 || index >= _size) {
+        return {};
+    }
+    const uint8_t* p = _data + static_cast<size_t>(index) * WORD_BYTES;
+    uint64_t code = 0;
+    for (int32_t i = WORD_BYTES - 1; i >= 0; --i) {
+        code = code << 8 | p[i];
+    }
+    return decode(code);
+}
+
+void MappedStorage::set(const int32_t index, const ComputerWord& word) {
+    store(index, &word, 1);
+}
+
+void MappedStorage::load(const int32_t index, ComputerWord* words, const int32_t count) {
+    prefetch(index, count);
+    for (int32_t i = 0; i < count; ++i) {
+        words[i] = get(index + i);
+    }
+}
+
+void MappedStorage::store(const int32_t index, const ComputerWord* words, const int32_t count) {
+    if (index < 0) {
+        throw std::out_of_range("Invalid location of device file: " + std::to_string(index));
+    }
+    if (index + count > _capacity) {
+        grow(index + count);
+    }
+    _size = std::max(_size, index + count);
+    for (int32_t i = 0; i < count; ++i) {
+        const uint64_t code = encode(words[i]);
+        uint8_t* p = _data + static_cast<size_t>(index + i) * WORD_BYTES;
+        for (int32_t j = 0; j < WORD_BYTES; ++j) {
+            p[j] = static_cast<uint8_t>(code >> (8 * j));
+        }
+    }
+}
+
+}  // namespace mixal
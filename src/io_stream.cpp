@@ -0,0 +1,77 @@
+#include <stdexcept>
+#include "io.h"
+
+/**
+ * @file
+ * @brief Streaming sources and sinks of the sequential devices.
+ */
+
+namespace mixal {
+
+TextBlockSource::TextBlockSource(std::istream& in) : _owned(), _nextLine([&in](std::string& line) {
+    return static_cast<bool>(std::getline(in, line));
+}) {}
+
+TextBlockSource::TextBlockSource(std::unique_ptr<std::istream> in) : _owned(std::move(in)), _nextLine() {
+    if (_owned == nullptr || !*_owned) {
+        throw std::runtime_error("Cannot read the source of the device");
+    }
+    _nextLine = [stream = _owned.get()](std::string& line) {
+        return static_cast<bool>(std::getline(*stream, line));
+    };
+}
+
+TextBlockSource::TextBlockSource(std::function<bool(std::string&)> nextLine) :
+    _owned(), _nextLine(std::move(nextLine)) {}
+
+bool TextBlockSource::next(ComputerWord* words, const int32_t count) {
+    std::string line;
+    if (!_nextLine(line)) {
+        return false;
+    }
+    while (!line.empty() && (line.back() == '\n' || line.back() == '\r')) {
+        line.pop_back();
+    }
+    convert(line, words, count);
+    return true;
+}
+
+void TextBlockSource::convert(const std::string& text, ComputerWord* words, const int32_t count) {
+    textToWords(text, words, count);
+}
+
+TextBlockSink::TextBlockSink(std::ostream& out) : _owned(), _stream(&out), _putLine([&out](const std::string& line) {
+    out << line << '\n';
+}) {}
+
+TextBlockSink::TextBlockSink(std::unique_ptr<std::ostream> out) : _owned(std::move(out)), _stream(), _putLine() {
+    if (_owned == nullptr || !*_owned) {
+        throw std::runtime_error("Cannot write the sink of the device");
+    }
+    _stream = _owned.get();
+    _putLine = [stream = _stream](const std::string& line) {
+        *stream << line << '\n';
+    };
+}
+
+TextBlockSink::TextBlockSink(std::function<void(const std::string&)> putLine) :
+    _owned(), _stream(), _putLine(std::move(putLine)) {}
+
+void TextBlockSink::put(const ComputerWord* words, const int32_t count) {
+    _putLine(convert(words, count));
+}
+
+void TextBlockSink::flush() {
+    if (_stream != nullptr) {
+        _stream->flush();
+    }
+}
+
+std::string TextBlockSink::convert(const ComputerWord* words, const int32_t count) {
+    std::string text = wordsToText(words, count);
+    const auto end = text.find_last_not_of(' ');
+    text.erase(end == std::string::npos ? 0 : end + 1);
+    return text;
+}
+
+}  // namespace mixal
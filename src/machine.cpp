@@ -2,8 +2,10 @@
 #include <set>
 #include <tuple>
 #include <sstream>
-#include <cassert>
 #include <ranges>
+#include <limits>
+#include <cstdlib>
+#include <utility>
 #include "machine.h"
 #include "parser.h"
 
@@ -12,24 +14,24 @@ namespace mixal {
 Computer::Computer() :
       overflow(false), comparison(ComparisonIndicator::EQUAL), memory(),
       devices(NUM_IO_DEVICE, nullptr),
-      _pseudoVarIndex(), _lineOffset(), _elapsed() {}
+      _pseudoVarIndex(), _lineOffset(), _elapsed(), _steps(),
+      _stepBudget(std::numeric_limits<int64_t>::max()), _elapsedBudget(std::numeric_limits<int64_t>::max()),
+      _operationCounts(),
+      _hasBreakpoints(false), _hasWatchpoints(false), _hasLimits(false),
+      _loopDetection(false), _idleFastForward(true), _interruptVector(-1), _controlState(false),
+      _memoryHashDirty(true), _memoryHash(), _loopStates(), _loopAnchor(), _loopAnchorPower(1), _loopAnchorDistance() {
+    resetPerformanceCounters();
+}
 
 Register2& Computer::rI(const int index) {
-    switch (index) {
-    case 1: return rI1;
-    case 2: return rI2;
-    case 3: return rI3;
-    case 4: return rI4;
-    case 5: return rI5;
-    case 6: return rI6;
-    }
-    throw RuntimeError(_lineOffset, "Invalid offset for index register: " + std::to_string(index));
+    if (index < 1 || NUM_INDEX_REGISTER < index) {
+        throw RuntimeError(_lineOffset, "Invalid offset for index register: " + std::to_string(index));
+    }
+    return indexRegister(index);
 }
 
 Computer::~Computer() {
-    for (const auto& device : devices) {
-        delete device;
-    }
+    releaseDevices();
 }
 
 const ComputerWord& Computer::memoryAt(const int16_t index) const {
@@ -44,7 +46,7 @@ void Computer::reset() {
     rA.reset();
     rX.reset();
     for (int i = 1; i <= NUM_INDEX_REGISTER; ++i) {
-        rI(i).reset();
+        indexRegister(i).reset();
     }
     rJ.reset();
     overflow = false;
@@ -52,13 +54,18 @@ void Computer::reset() {
     for (int i = 0; i < NUM_MEMORY; ++i) {
         memory[i].reset();
     }
-    for (size_t i = 0; i < NUM_IO_DEVICE; ++i) {
-        devices[i] = nullptr;
-    }
+    releaseDevices();
     _pseudoVarIndex = 0;
     _lineOffset = 0;
     _elapsed = 0;
+    _controlState = false;
+    _interruptArmed.reset();
+    _interruptPending.reset();
+    resetPerformanceCounters();
+    clearDeviceTrace();
     _constants.clear();
+    _usage = ResourceUsage();
+    _fault = Fault();
 }
 
 std::string Computer::getSingleLineSymbol() {
@@ -71,16 +78,53 @@ void Computer::executeSingle() {
     executeSingle(memory[_lineOffset]);
 }
 
+void Computer::raiseFault(const FaultCode code, const InstructionWord& instruction,
+                          const int32_t operand, const int32_t blockSize) {
+    if (!faulted()) {
+        _fault = {code, _lineOffset, instruction, operand, blockSize};
+    }
+}
+
+StopInfo Computer::reportFault() {
+    const auto fault = std::exchange(_fault, Fault());
+    return {StopReason::ERROR, fault.line, -1, fault.message(), ResourceKind::NONE, fault};
+}
+
+void Computer::throwFault() {
+    const auto fault = std::exchange(_fault, Fault());
+    throw RuntimeError(fault.line, fault.message());
+}
+
 void Computer::executeUntilSelfLoop() {
     int32_t lastOffset = _lineOffset;
+    if (_loopDetection) {
+        resetLoopDetection();
+    }
     while (true) {
         if (_lineOffset < 0 || NUM_MEMORY <= _lineOffset) {
-            throw RuntimeError(_lineOffset, "Invalid code line: " + std::to_string(_lineOffset));
+            raiseFault(FaultCode::INVALID_LINE, InstructionWord(), _lineOffset);
+            throwFault();
+        }
+        if (_hasLimits) {
+            enforceResourceLimits();
+        }
+        bool repeated = false;
+        if (!faulted()) {
+            if (_loopDetection) {
+                repeated = executeDetectingLoop(memory[_lineOffset]);
+            } else {
+                executeInstruction(memory[_lineOffset]);
+            }
+        }
+        if (faulted()) {
+            throwFault();
+        }
+        if (repeated) {
+            break;
         }
-        executeSingle(memory[_lineOffset]);
         if (memory[_lineOffset].operation() != Instructions::JBUS
             && memory[_lineOffset].operation() != Instructions::JRED
-            && lastOffset == _lineOffset) {
+            && lastOffset == _lineOffset && !interruptExpected()) {
             break;
         }
         lastOffset = _lineOffset;
@@ -88,36 +132,70 @@ void Computer::executeUntilSelfLoop() {
     waitDevices();
 }
 
-void Computer::executeUntilHalt() {
-    while (true) {
-        if (_lineOffset < 0 || NUM_MEMORY <= _lineOffset) {
-            throw RuntimeError(_lineOffset, "Invalid code line: " + std::to_string(_lineOffset));
+bool Computer::stepOrHalt() {
+    if (_lineOffset < 0 || NUM_MEMORY <= _lineOffset) {
+        raiseFault(FaultCode::INVALID_LINE, InstructionWord(), _lineOffset);
+        return false;
+    }
+    if (memory[_lineOffset].operation() == Instructions::HLT &&
+        memory[_lineOffset].field() == 2) {
+        ++_lineOffset;
+        return true;
+    }
+    if (_hasLimits) {
+        enforceResourceLimits();
+        if (faulted()) {
+            return false;
         }
-        if (memory[_lineOffset].operation() == Instructions::HLT &&
-            memory[_lineOffset].field() == 2) {
-            ++_lineOffset;
-            break;
+    }
+    executeInstruction(memory[_lineOffset]);
+    return false;
+}
+
+void Computer::executeUntilHalt() {
+    while (!stepOrHalt()) {
+        if (faulted()) {
+            throwFault();
         }
-        executeSingle(memory[_lineOffset]);
     }
     waitDevices();
 }
 
 void Computer::executeUntilHaltOrSelfLoop() {
     int32_t lastOffset = _lineOffset;
+    if (_loopDetection) {
+        resetLoopDetection();
+    }
     while (true) {
         if (_lineOffset < 0 || NUM_MEMORY <= _lineOffset) {
-            throw RuntimeError(_lineOffset, "Invalid code line: " + std::to_string(_lineOffset));
+            raiseFault(FaultCode::INVALID_LINE, InstructionWord(), _lineOffset);
+            throwFault();
         }
         if (memory[_lineOffset].operation() == Instructions::HLT &&
             memory[_lineOffset].field() == 2) {
             ++_lineOffset;
             break;
         }
-        executeSingle(memory[_lineOffset]);
+        if (_hasLimits) {
+            enforceResourceLimits();
+        }
+        bool repeated = false;
+        if (!faulted()) {
+            if (_loopDetection) {
+                repeated = executeDetectingLoop(memory[_lineOffset]);
+            } else {
+                executeInstruction(memory[_lineOffset]);
+            }
+        }
+        if (faulted()) {
+            throwFault();
+        }
+        if (repeated) {
+            break;
+        }
         if (memory[_lineOffset].operation() != Instructions::JBUS
             && memory[_lineOffset].operation() != Instructions::JRED
-            && lastOffset == _lineOffset) {
+            && lastOffset == _lineOffset && !interruptExpected()) {
             break;
         }
         lastOffset = _lineOffset;
@@ -125,6 +203,77 @@ void Computer::executeUntilHaltOrSelfLoop() {
     waitDevices();
 }
 
+StopInfo Computer::run(const int64_t maxSteps, const int64_t maxElapsed) {
+    constexpr int64_t UNLIMITED = std::numeric_limits<int64_t>::max();
+    // The skipped polls are counted in the steps, so the budget is compared with the steps of the machine.
+    const int64_t stepLimit = maxSteps < 0 ? UNLIMITED : _steps + maxSteps;
+    const int64_t elapsedLimit = maxElapsed < 0 ? UNLIMITED : _elapsed + maxElapsed;
+    struct BudgetScope {
+        Computer* machine;
+        ~BudgetScope() { machine->setBudget(); }
+    } budgetScope{this};
+    setBudget(stepLimit, elapsedLimit);
+    int32_t lastOffset = _lineOffset;
+    bool resumed = true;
+    if (_loopDetection) {
+        resetLoopDetection();
+    }
+    for (int64_t steps = 0; ; ++steps) {
+        if (_lineOffset < 0 || NUM_MEMORY <= _lineOffset) {
+            raiseFault(FaultCode::INVALID_LINE, InstructionWord(), _lineOffset);
+            return reportFault();
+        }
+        const int32_t line = _lineOffset;
+        if (_hasBreakpoints && !resumed && _breakpoints.test(line) && triggerBreakpoint(line)) {
+            return {StopReason::BREAKPOINT, line, -1, ""};
+        }
+        resumed = false;
+        if (_steps >= stepLimit || _elapsed >= elapsedLimit) {
+            return {StopReason::BUDGET_EXHAUSTED, line, -1, ""};
+        }
+        const auto& instruction = memory[line];
+        if (instruction.operation() == Instructions::HLT && instruction.field() == 2) {
+            ++_lineOffset;
+            waitDevices();
+            return {StopReason::HALT, line, -1, ""};
+        }
+        if (instruction.operation() == Instructions::IN && instruction.field() < NUM_IO_DEVICE) {
+            if (const auto device = findDevice(instruction.field()); device != nullptr && device->exhausted()) {
+                return {StopReason::WAITING_FOR_INPUT, line, -1, ""};
+            }
+        }
+        if (_hasLimits) {
+            if (const auto resource = checkResourceLimits(instruction, steps); resource != ResourceKind::NONE) {
+                return {StopReason::RESOURCE_LIMIT, line, -1, "", resource};
+            }
+        }
+        StopReason watchReason = StopReason::WATCH_READ;
+        const int32_t watched = _hasWatchpoints ? findWatchedAddress(instruction, &watchReason) : -1;
+        bool repeated = false;
+        if (_loopDetection) {
+            repeated = executeDetectingLoop(instruction);
+        } else {
+            executeInstruction(instruction);
+        }
+        if (faulted()) {
+            return reportFault();
+        }
+        if (watched != -1) {
+            return {watchReason, line, watched, ""};
+        }
+        if (memory[_lineOffset].operation() != Instructions::JBUS
+            && memory[_lineOffset].operation() != Instructions::JRED
+            && lastOffset == _lineOffset && !interruptExpected()) {
+            waitDevices();
+            return {StopReason::SELF_LOOP, line, -1, ""};
+        }
+        if (repeated) {
+            return {StopReason::NON_TERMINATING_LOOP, line, -1, ""};
+        }
+        lastOffset = _lineOffset;
+    }
+}
+
 void Computer::executeSingle(ParsedResult* instruction) {
     if (instruction->address.literalConstant() ||
         instruction->index.literalConstant() ||
@@ -144,6 +293,13 @@ void Computer::executeSingle(ParsedResult* instruction) {
 }
 
 void Computer::executeSingle(const InstructionWord& instruction) {
+    executeInstruction(instruction);
+    if (faulted()) {
+        throwFault();
+    }
+}
+
+void Computer::executeInstruction(const InstructionWord& instruction) {
     switch (instruction.operation()) {
     case Instructions::ADD:
         if (instruction.field() == 6) {
@@ -179,6 +335,7 @@ void Computer::executeSingle(const InstructionWord& instruction) {
         case 1: executeCHAR(); break;
         case 6: executeFLOT(); break;
         case 7: executeFIX(); break;
+        case 9: executeINT(); break;
         }
         break;
     case Instructions::SLA:
@@ -354,9 +511,11 @@ void Computer::executeSingle(const InstructionWord& instruction) {
         executeCMP(instruction, &rX);
         break;
     }
-    ++_lineOffset;
-    _elapsed += Instructions::getCost(static_cast<Instructions::Code>(instruction.operation()),
-                                      instruction.field());
+    if (faulted()) {
+        return;
+    }
+    retire(instruction.operation(), instruction.field(),
+           Instructions::getCost(static_cast<Instructions::Code>(instruction.operation()), instruction.field()));
 }
 
 void Computer::executeSinglePseudo(ParsedResult* instruction) {
@@ -584,26 +743,26 @@ std::string Computer::getPseudoSymbolName() {
 }
 
 int32_t Computer::getIndexedAddress(const InstructionWord& instruction, bool checkRange) {
-    int32_t offset = 0;
-    if (instruction.index() != 0) {
-        const auto& rIi = rI(instruction.index());
-        offset = static_cast<int32_t>(rIi.value());
+    const int index = instruction.index();
+    if (index > NUM_INDEX_REGISTER) {
+        raiseFault(FaultCode::INVALID_INDEX, instruction, index);
+        return 0;
     }
-    const int32_t address = static_cast<int32_t>(instruction.addressValue()) + offset;
+    const int32_t address = static_cast<int32_t>(instruction.addressValue()) + indexRegister(index).value();
     if (checkRange && !(0 <= address && address < NUM_MEMORY)) {
-        throw RuntimeError(_lineOffset, "Invalid address in instruction '" + instruction.getBytesString() +
-                                        "': " + std::to_string(address));
+        raiseFault(FaultCode::INVALID_ADDRESS, instruction, address);
+        return 0;
     }
     return address;
 }
 
-void Computer::copyToRegister5(const InstructionWord& instruction, const ComputerWord& word, Register5* reg) const {
+void Computer::copyToRegister5(const InstructionWord& instruction, const ComputerWord& word, Register5* reg) {
     int32_t start = instruction.field() / 8;
     const int32_t stop = instruction.field() % 8;
     reg->reset();
     if (start > stop || stop > 5) {
-        throw RuntimeError(_lineOffset, "Invalid field value: ("
-                                        + std::to_string(start) + ":" + std::to_string(stop) + ")");
+        raiseFault(FaultCode::INVALID_FIELD, instruction, instruction.field());
+        return;
     }
     if (start == 0) {
         reg->negative = word.negative;
@@ -614,12 +773,12 @@ void Computer::copyToRegister5(const InstructionWord& instruction, const Compute
     }
 }
 
-void Computer::copyFromRegister5(const InstructionWord& instruction, const Register5& reg, ComputerWord* word) const {
+void Computer::copyFromRegister5(const InstructionWord& instruction, const Register5& reg, ComputerWord* word) {
     int32_t start = instruction.field() / 8;
     const int32_t stop = instruction.field() % 8;
     if (start > stop || stop > 5) {
-        throw RuntimeError(_lineOffset, "Invalid field value: ("
-                                        + std::to_string(start) + ":" + std::to_string(stop) + ")");
+        raiseFault(FaultCode::INVALID_FIELD, instruction, instruction.field());
+        return;
     }
     if (start == 0) {
         word->negative = reg.negative;
@@ -630,12 +789,12 @@ void Computer::copyFromRegister5(const InstructionWord& instruction, const Regis
     }
 }
 
-void Computer::copyToRegister2(const InstructionWord& instruction, const ComputerWord& word, Register2* reg) const {
+void Computer::copyToRegister2(const InstructionWord& instruction, const ComputerWord& word, Register2* reg) {
     int32_t start = instruction.field() / 8;
     const int32_t stop = instruction.field() % 8;
     if (start > stop || stop > 5) {
-        throw RuntimeError(_lineOffset, "Invalid field value: ("
-                                        + std::to_string(start) + ":" + std::to_string(stop) + ")");
+        raiseFault(FaultCode::INVALID_FIELD, instruction, instruction.field());
+        return;
     }
     reg->reset();
     if (start == 0) {
@@ -652,28 +811,14 @@ void Computer::copyToRegister2(const InstructionWord& instruction, const Compute
  * Overflow will be triggered if the value can not be fitted into 5 bytes.
  * (Which means rI will not trigger overflow.)
  */
-int32_t Computer::checkRange(int32_t value, const int bytes) {
-    if (const int32_t range = 1 << (6 * bytes); std::abs(value) >= range) {
+WordValue Computer::checkRange(WordValue value, const int bytes) {
+    if (const auto range = static_cast<WordValue>(WordFormat::power(bytes)); std::abs(value) >= range) {
         if (bytes == 5) {
-            overflow = true;
+            triggerOverflow();
         }
         value %= range;
     }
     return value;
 }
 
-uint8_t Computer::getAX(const int index) const {
-    assert(1 <= index && index <= 10);
-    return index <= 5 ? rA[index] : rX[index - 5];
-}
-
-void Computer::setAX(const int index, const uint8_t value) {
-    assert(1 <= index && index <= 10);
-    if (index <= 5) {
-        rA[index] = value;
-    } else {
-        rX[index - 5] = value;
-    }
-}
-
 }  // namespace mixal
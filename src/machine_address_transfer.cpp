@@ -13,8 +13,11 @@ namespace mixal {
  * @see overflow
  */
 void Computer::executeINC(const InstructionWord& instruction, Register5* reg) {
-    const int32_t value = reg->value();
+    const WordValue value = reg->value();
     const int32_t address = getIndexedAddress(instruction);
+    if (faulted()) {
+        return;
+    }
     reg->set(checkRange(value + address));
 }
 
@@ -23,14 +26,20 @@ void Computer::executeINC(const InstructionWord& instruction, Register5* reg) {
  * @see overflow
  */
 void Computer::executeDEC(const InstructionWord& instruction, Register5* reg) {
-    const int32_t value = reg->value();
+    const WordValue value = reg->value();
     const int32_t address = getIndexedAddress(instruction);
+    if (faulted()) {
+        return;
+    }
     reg->set(checkRange(value - address));
 }
 
 /** Enter the immediate address value to rA or rX. */
 void Computer::executeENT(const InstructionWord& instruction, Register5* reg) {
     const int32_t address = getIndexedAddress(instruction);
+    if (faulted()) {
+        return;
+    }
     reg->set(address);
     if (address == 0) {
         reg->negative = instruction.negative;
@@ -40,6 +49,9 @@ void Computer::executeENT(const InstructionWord& instruction, Register5* reg) {
 /** Enter the negative immediate address value to rA or rX. */
 void Computer::executeENN(const InstructionWord& instruction, Register5* reg) {
     const int32_t address = getIndexedAddress(instruction);
+    if (faulted()) {
+        return;
+    }
     reg->set(-address);
     if (address == 0) {
         reg->negative = !instruction.negative;
@@ -49,26 +61,35 @@ void Computer::executeENN(const InstructionWord& instruction, Register5* reg) {
 /** Increase rI by the address value. */
 void Computer::executeINCi(const InstructionWord& instruction) {
     const int registerIndex = instruction.operation() - Instructions::INC1 + 1;
-    auto& rIi = rI(registerIndex);
+    auto& rIi = indexRegister(registerIndex);
     const int16_t value = rIi.value();
     const int16_t address = getIndexedAddress(instruction);
+    if (faulted()) {
+        return;
+    }
     rIi.set(checkRange(value + address, 2));
 }
 
 /** Decrease rI by the address value. */
 void Computer::executeDECi(const InstructionWord& instruction) {
     const int registerIndex = instruction.operation() - Instructions::INC1 + 1;
-    auto& rIi = rI(registerIndex);
+    auto& rIi = indexRegister(registerIndex);
     const int16_t value = rIi.value();
     const int16_t address = getIndexedAddress(instruction);
+    if (faulted()) {
+        return;
+    }
     rIi.set(checkRange(value - address, 2));
 }
 
 /** Enter address value to rI. */
 void Computer::executeENTi(const InstructionWord& instruction) {
     const int registerIndex = instruction.operation() - Instructions::INC1 + 1;
-    auto& rIi = rI(registerIndex);
+    auto& rIi = indexRegister(registerIndex);
     const int16_t address = getIndexedAddress(instruction);
+    if (faulted()) {
+        return;
+    }
     rIi.set(checkRange(address, 2));
     if (address == 0) {
         rIi.negative = instruction.negative;
@@ -78,8 +99,11 @@ void Computer::executeENTi(const InstructionWord& instruction) {
 /** Enter negative address value to rI. */
 void Computer::executeENNi(const InstructionWord& instruction) {
     const int registerIndex = instruction.operation() - Instructions::INC1 + 1;
-    auto& rIi = rI(registerIndex);
+    auto& rIi = indexRegister(registerIndex);
     const int16_t address = getIndexedAddress(instruction);
+    if (faulted()) {
+        return;
+    }
     rIi.set(checkRange(-address, 2));
     if (address == 0) {
         rIi.negative = !instruction.negative;
@@ -1,5 +1,7 @@
 #include <iostream>
 #include <cmath>
+#include <type_traits>
+#include <utility>
 #include "machine.h"
 
 /**
@@ -9,17 +11,91 @@
 
 namespace mixal {
 
+namespace {
+
+/** The number of values of a word. */
+constexpr int64_t WORD_RANGE = WordFormat::power(5);
+
+/** The high and low words of the product of two magnitudes, when the product does not fit in 64 bits. */
+std::pair<int64_t, int64_t> multiplyWords(const int64_t a, const int64_t b) {
+    using F = WordFormat;
+    const int64_t upper = F::shiftRight(a, 3) * b;
+    const int64_t lower = F::lowBytes(a, 3) * b;
+    const int64_t low = F::lowBytes(upper, 2) * F::power(3) + F::lowBytes(lower, 5);
+    return {F::shiftRight(upper, 2) + F::shiftRight(lower, 5) + F::shiftRight(low, 5), F::lowBytes(low, 5)};
+}
+
+/** The quotient modulo the word range and the remainder of the magnitudes `(high * WORD_RANGE + low) / divisor`,
+ * computed one byte at a time when the dividend does not fit in 64 bits. */
+std::pair<int64_t, int64_t> divideWords(const int64_t high, const int64_t low, const int64_t divisor) {
+    using F = WordFormat;
+    int64_t quotient = 0, remainder = high % divisor;
+    for (int i = 4; i >= 0; --i) {
+        remainder = F::combine<int64_t>(remainder, F::byteAt(low, i));
+        quotient = F::combine<int64_t>(quotient, remainder / divisor);
+        remainder %= divisor;
+    }
+    return {quotient, remainder};
+}
+
+/** Add or subtract the float in the word to the float in the register, Algorithm 4.2.1A of TAOCP.
+ *
+ * The operand with the smaller exponent is shifted right by at most five bytes into an accumulator of nine bytes,
+ * so the sum is exact before it is normalized. It is ignored when the exponents differ by six or more.
+ *
+ * @return Overflow
+ */
+bool addFloats(ComputerWord* reg, const ComputerWord& word, const bool subtract) {
+    constexpr int DIGITS = 2 * ComputerWord::MIX_FLOAT_DIGITS + 1;
+    constexpr int MAX_SHIFT = ComputerWord::MIX_FLOAT_DIGITS + 1;
+    const ComputerWord* u = reg;
+    const ComputerWord* v = &word;
+    bool negativeU = reg->negative, negativeV = word.negative != subtract;
+    if (u->byte1 < v->byte1) {
+        std::swap(u, v);
+        std::swap(negativeU, negativeV);
+    }
+    const int32_t exponent = u->byte1;
+    const int32_t difference = u->byte1 - v->byte1;
+    int64_t fraction = u->floatFraction() * WordFormat::power(MAX_SHIFT);
+    if (difference <= MAX_SHIFT) {
+        const int64_t scaled = v->floatFraction() * WordFormat::power(MAX_SHIFT - difference);
+        fraction += negativeU == negativeV ? scaled : -scaled;
+    }
+    if (fraction < 0) {
+        negativeU = !negativeU;
+        fraction = -fraction;
+    }
+    return reg->setFloat(negativeU, exponent, fraction, DIGITS);
+}
+
+/** The exponent and the fraction of a float, with the fraction shifted until its highest byte is not zero. */
+std::pair<int32_t, int64_t> normalizedFloat(const ComputerWord& word) {
+    int32_t exponent = word.byte1;
+    int64_t fraction = word.floatFraction();
+    while (fraction != 0 && fraction < WordFormat::power(ComputerWord::MIX_FLOAT_DIGITS - 1)) {
+        fraction *= BYTE_SIZE;
+        --exponent;
+    }
+    return {exponent, fraction};
+}
+
+}  // namespace
+
 /** Add the values of rA and the word in the memory into rA.
  * 
  * @see overflow
  */
 void Computer::executeADD(const InstructionWord& instruction) {
-    const int32_t valueA = rA.value();
+    const WordValue valueA = rA.value();
     ComputerWord word;
     const int address = getIndexedAddress(instruction, true);
     copyToRegister5(instruction, memory[address], &word);
-    const int32_t valueM = word.value();
-    const int32_t result = valueA + valueM;
+    if (faulted()) {
+        return;
+    }
+    const WordValue valueM = word.value();
+    const WordValue result = valueA + valueM;
     rA.set(checkRange(result));
 }
 
@@ -28,13 +104,16 @@ void Computer::executeADD(const InstructionWord& instruction) {
  * @see overflow
  */
 void Computer::executeSUB(const InstructionWord& instruction) {
-    const int32_t valueA = rA.value();
+    const WordValue valueA = rA.value();
     ComputerWord word;
     const int address = getIndexedAddress(instruction, true);
     copyToRegister5(instruction, memory[address], &word);
+    if (faulted()) {
+        return;
+    }
     word.negative = !word.negative;
-    const int32_t valueM = word.value();
-    const int32_t result = valueA + valueM;
+    const WordValue valueM = word.value();
+    const WordValue result = valueA + valueM;
     rA.set(checkRange(result));
 }
 
@@ -43,14 +122,24 @@ void Computer::executeSUB(const InstructionWord& instruction) {
  * Note that overflow will never be triggered.
  */
 void Computer::executeMUL(const InstructionWord& instruction) {
-    const int32_t valueA = rA.value();
+    const WordValue valueA = rA.value();
     ComputerWord word;
     const int address = getIndexedAddress(instruction, true);
     copyToRegister5(instruction, memory[address], &word);
-    const int32_t valueM = word.value();
-    const int64_t result = static_cast<int64_t>(valueA) * static_cast<int64_t>(valueM);
-    rA.set(static_cast<int32_t>(result / (1 << 30)));
-    rX.set(static_cast<int32_t>(result % (1 << 30)));
+    if (faulted()) {
+        return;
+    }
+    const WordValue valueM = word.value();
+    if constexpr (std::is_same_v<WordValue, int32_t>) {
+        const int64_t result = static_cast<int64_t>(valueA) * static_cast<int64_t>(valueM);
+        rA.set(static_cast<int32_t>(result / WORD_RANGE));
+        rX.set(static_cast<int32_t>(result % WORD_RANGE));
+    } else {
+        const auto [high, low] = multiplyWords(std::abs(valueA), std::abs(valueM));
+        const bool negative = (valueA < 0) != (valueM < 0);
+        rA.set(negative ? -high : high);
+        rX.set(negative ? -low : low);
+    }
 }
 
 /** Divide the value of rA and rX with the value of the word in the memory.
@@ -59,30 +148,44 @@ void Computer::executeMUL(const InstructionWord& instruction) {
  * 
  * @see overflow
  * 
- * @throw mixal::RuntimeError When the divisor is 0.
+ * A zero divisor raises a fault.
  */
 void Computer::executeDIV(const InstructionWord& instruction) {
-    const int32_t valueA = std::abs(rA.value());
-    const int32_t valueX = std::abs(rX.value());
-    int64_t dividend = (static_cast<int64_t>(valueA) << 30) + static_cast<int64_t>(valueX);
-    if (rA.negative) {
-        dividend = -dividend;
-    }
     ComputerWord word;
     const int address = getIndexedAddress(instruction, true);
     copyToRegister5(instruction, memory[address], &word);
-    const int32_t divisor = word.value();
+    if (faulted()) {
+        return;
+    }
+    const WordValue divisor = word.value();
     if (divisor == 0) {
-        throw RuntimeError(_lineOffset, "Divisor cannot be 0");
+        raiseFault(FaultCode::DIVISION_BY_ZERO, instruction);
+        return;
     }
-    int64_t quotient = dividend / divisor;
-    if (std::abs(quotient) >= (1 << 30)) {
-        overflow = true;
-        quotient %= (1 << 30);
+    if constexpr (std::is_same_v<WordValue, int32_t>) {
+        int64_t dividend = static_cast<int64_t>(unitsAX());
+        if (rA.negative) {
+            dividend = -dividend;
+        }
+        int64_t quotient = dividend / divisor;
+        if (std::abs(quotient) >= WORD_RANGE) {
+            triggerOverflow();
+            quotient %= WORD_RANGE;
+        }
+        const int32_t remainder = static_cast<int32_t>(dividend % divisor);
+        rA.set(static_cast<int32_t>(quotient));
+        rX.set(remainder);
+    } else {
+        const bool negative = rA.negative;
+        const WordValue valueA = std::abs(rA.value());
+        const WordValue valueX = std::abs(rX.value());
+        if (valueA >= std::abs(divisor)) {
+            triggerOverflow();
+        }
+        const auto [quotient, remainder] = divideWords(valueA, valueX, std::abs(divisor));
+        rA.set(negative != (divisor < 0) ? -quotient : quotient);
+        rX.set(negative ? -remainder : remainder);
     }
-    const int32_t remainder = dividend % divisor;
-    rA.set(static_cast<int32_t>(quotient));
-    rX.set(remainder);
 }
 
 /** Add the float values of rA and the word in the memory into rA.
@@ -90,12 +193,12 @@ void Computer::executeDIV(const InstructionWord& instruction) {
  * @see overflow
  */
 void Computer::executeFADD(const InstructionWord& instruction) {
-    const double valueA = rA.floatValue();
     const int address = getIndexedAddress(instruction, true);
-    const double valueM = memory[address].floatValue();
-    const double result = valueA + valueM;
-    if (rA.set(result)) {
-        overflow = true;
+    if (faulted()) {
+        return;
+    }
+    if (addFloats(&rA, memory[address], false)) {
+        triggerOverflow();
     }
 }
 
@@ -104,47 +207,61 @@ void Computer::executeFADD(const InstructionWord& instruction) {
  * @see overflow
  */
 void Computer::executeFSUB(const InstructionWord& instruction) {
-    const double valueA = rA.floatValue();
     const int address = getIndexedAddress(instruction, true);
-    const double valueM = memory[address].floatValue();
-    const double result = valueA - valueM;
-    if (rA.set(result)) {
-        overflow = true;
+    if (faulted()) {
+        return;
+    }
+    if (addFloats(&rA, memory[address], true)) {
+        triggerOverflow();
     }
 }
 
-/** Multiply the float values of rA and the word in the memory into rA and rX.
+/** Multiply the float values of rA and the word in the memory into rA.
+ *
+ * The product of the fractions is exact before it is normalized, Algorithm 4.2.1M of TAOCP.
  *
  * @see overflow
  */
 void Computer::executeFMUL(const InstructionWord& instruction) {
-    const double valueA = rA.floatValue();
     const int address = getIndexedAddress(instruction, true);
-    const double valueM = memory[address].floatValue();
-    const double result = valueA * valueM;
-    if (rA.set(result)) {
-        overflow = true;
+    if (faulted()) {
+        return;
+    }
+    const auto& word = memory[address];
+    const int32_t exponent = rA.byte1 + word.byte1 - ComputerWord::MIX_FLOAT_BIAS;
+    if (rA.setFloat(rA.negative != word.negative, exponent, rA.floatFraction() * word.floatFraction(),
+                    2 * ComputerWord::MIX_FLOAT_DIGITS)) {
+        triggerOverflow();
     }
 }
 
-/** Divide the float values of rA and rX with the value of the word in the memory.
+/** Divide the float value of rA by the value of the word in the memory into rA.
  *
- * The quotient will be placed in rA and the remainder will be placed in rX.
+ * Algorithm 4.2.1M of TAOCP. The operands are normalized first, which keeps the exact quotient,
+ * so that a quotient of six bytes and whether its remainder is zero decide the rounding.
  *
  * @see overflow
  *
- * @throw mixal::RuntimeError When the divisor is 0.
+ * A zero divisor raises a fault.
  */
 void Computer::executeFDIV(const InstructionWord& instruction) {
-    const double valueA = rA.floatValue();
     const int address = getIndexedAddress(instruction, true);
-    const double valueM = memory[address].floatValue();
-    if (valueM == 0.0) {
-        throw RuntimeError(_lineOffset, "Floating-point divisor cannot be 0");
+    if (faulted()) {
+        return;
+    }
+    const auto& word = memory[address];
+    const auto [exponentV, fractionV] = normalizedFloat(word);
+    if (fractionV == 0) {
+        raiseFault(FaultCode::FLOAT_DIVISION_BY_ZERO, instruction);
+        return;
     }
-    const double result = valueA / valueM;
-    if (rA.set(result)) {
-        overflow = true;
+    const auto [exponentU, fractionU] = normalizedFloat(rA);
+    constexpr int DIGITS = ComputerWord::MIX_FLOAT_DIGITS + 2;
+    const int64_t dividend = fractionU * WordFormat::power(DIGITS - 1);
+    const int32_t exponent = exponentU - exponentV + ComputerWord::MIX_FLOAT_BIAS + 1;
+    if (rA.setFloat(rA.negative != word.negative, exponent, dividend / fractionV, DIGITS,
+                    dividend % fractionV != 0)) {
+        triggerOverflow();
     }
 }
 
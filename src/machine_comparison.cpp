@@ -9,6 +9,29 @@
 
 namespace mixal {
 
+namespace {
+
+/** An integer with the same order as the float value of the word.
+ *
+ * The fraction is shifted until its highest byte is not zero, then the exponent is compared before the fraction.
+ */
+int64_t floatOrder(const ComputerWord& word) {
+    constexpr int64_t FRACTION_RANGE = WordFormat::power(ComputerWord::MIX_FLOAT_DIGITS);
+    int64_t exponent = word.byte1;
+    int64_t fraction = word.floatFraction();
+    if (fraction == 0) {
+        return 0;
+    }
+    while (fraction < FRACTION_RANGE / BYTE_SIZE) {
+        fraction *= BYTE_SIZE;
+        --exponent;
+    }
+    const int64_t order = (exponent + ComputerWord::MIX_FLOAT_DIGITS) * FRACTION_RANGE + fraction;
+    return word.negative ? -order : order;
+}
+
+}  // namespace
+
 /** Compare the values in rA or rX and the word in memory.
  * 
  * @see comparison
@@ -18,7 +41,10 @@ void Computer::executeCMP(const InstructionWord& instruction, Register5* reg) {
     const int32_t address = getIndexedAddress(instruction, true);
     copyToRegister5(instruction, *reg, &a);
     copyToRegister5(instruction, memory[address], &b);
-    const int32_t aVal = a.value(), bVal = b.value();
+    if (faulted()) {
+        return;
+    }
+    const WordValue aVal = a.value(), bVal = b.value();
     if (aVal < bVal) {
         comparison = ComparisonIndicator::LESS;
     } else if (aVal > bVal) {
@@ -34,13 +60,16 @@ void Computer::executeCMP(const InstructionWord& instruction, Register5* reg) {
  */
 void Computer::executeCMPi(const InstructionWord& instruction) {
     const int registerIndex = instruction.operation() - Instructions::CMP1 + 1;
-    const auto& rIi = rI(registerIndex);
+    const auto& rIi = indexRegister(registerIndex);
     const ComputerWord t(rIi.negative, 0, 0, 0, rIi.byte1, rIi.byte2);
     ComputerWord a, b;
     const int32_t address = getIndexedAddress(instruction, true);
     copyToRegister5(instruction, t, &a);
     copyToRegister5(instruction, memory[address], &b);
-    const int32_t aVal = a.value(), bVal = b.value();
+    if (faulted()) {
+        return;
+    }
+    const WordValue aVal = a.value(), bVal = b.value();
     if (aVal < bVal) {
         comparison = ComparisonIndicator::LESS;
     } else if (aVal > bVal) {
@@ -50,14 +79,17 @@ void Computer::executeCMPi(const InstructionWord& instruction) {
     }
 }
 
-/** Compare the float values in rI and the word in memory.
+/** Compare the float values in rA and the word in memory exactly.
  *
  * @see comparison
  */
 void Computer::executeFCMP(const InstructionWord& instruction) {
-    const double valueA = rA.floatValue();
     const int32_t address = getIndexedAddress(instruction, true);
-    const double valueM = memory[address].floatValue();
+    if (faulted()) {
+        return;
+    }
+    const int64_t valueA = floatOrder(rA);
+    const int64_t valueM = floatOrder(memory[address]);
     if (valueA < valueM) {
         comparison = ComparisonIndicator::LESS;
     } else if (valueA > valueM) {
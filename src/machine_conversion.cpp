@@ -23,17 +23,17 @@ void Computer::executeNUM() {
         num = num * 10 + rX[i] % 10;
     }
     const bool negative = rA.negative;
-    if (num >= (1 << 30)) {
-        overflow = true;
-        num %= (1 << 30);
+    if (constexpr int64_t range = WordFormat::power(5); num >= range) {
+        triggerOverflow();
+        num %= range;
     }
-    rA.set(static_cast<int32_t>(num));
+    rA.set(static_cast<WordValue>(num));
     rA.negative = negative;
 }
 
 /** Convert number in rA to chars, and save the result to rA and rX. */
 void Computer::executeCHAR() {
-    int32_t num = std::abs(rA.value());
+    WordValue num = std::abs(rA.value());
     for (int i = 5; i >= 1; --i) {
         rX[i] = 30 + num % 10;
         num /= 10;
@@ -44,24 +44,26 @@ void Computer::executeCHAR() {
     }
 }
 
+/** Convert the integer in rA to a float, which is rounded with the same normalization as FADD. */
 void Computer::executeFLOT() {
-    rA.set(static_cast<double>(rA.value()));
+    const WordValue value = rA.value();
+    rA.setFloat(value < 0, ComputerWord::MIX_FLOAT_BIAS + 5, std::abs(value), 5);
 }
 
 void Computer::executeFIX() {
     const double value = rA.floatValue();
-    if (value < static_cast<double>(std::numeric_limits<int32_t>::min())) {
-        overflow = true;
-        rA.set('+', 63, 63, 63, 63, 63);
+    constexpr auto MAX_BYTE = static_cast<uint8_t>(BYTE_SIZE - 1);
+    if (value < static_cast<double>(std::numeric_limits<WordValue>::min())) {
+        triggerOverflow();
+        rA.set('+', MAX_BYTE, MAX_BYTE, MAX_BYTE, MAX_BYTE, MAX_BYTE);
         return;
     }
-    if (value > static_cast<double>(std::numeric_limits<int32_t>::max())) {
-        overflow = true;
-        rA.set('-', 63, 63, 63, 63, 63);
+    if (value > static_cast<double>(std::numeric_limits<WordValue>::max())) {
+        triggerOverflow();
+        rA.set('-', MAX_BYTE, MAX_BYTE, MAX_BYTE, MAX_BYTE, MAX_BYTE);
         return;
     }
-    rA.set(static_cast<int32_t>(round(rA.floatValue())));
-    checkRange(rA.value());
+    rA.set(checkRange(static_cast<WordValue>(round(value))));
 }
 
 }  // namespace mixal
@@ -0,0 +1,60 @@
+#include <numeric>
+#include "machine.h"
+
+/**
+ * @file
+ * @brief Performance counters.
+ */
+
+namespace mixal {
+
+void Computer::setCountersEnabled(const bool enabled) {
+    if (enabled) {
+        _counters.instructions.assign(PerformanceCounters::NUM_OPERATIONS * PerformanceCounters::NUM_FIELDS, 0);
+    } else {
+        _counters.instructions.clear();
+        _counters.instructions.shrink_to_fit();
+    }
+    resetPerformanceCounters();
+}
+
+void Computer::resetPerformanceCounters() {
+    _steps = 0;
+    _operationCounts.fill(0);
+    std::fill(_counters.instructions.begin(), _counters.instructions.end(), 0);
+    _counters.jumpsTaken = 0;
+    _counters.overflows = 0;
+    _counters.movedWords = 0;
+    _counters.deviceWaitCycles.assign(NUM_IO_DEVICE, 0);
+    _counters.deviceInputWords.assign(NUM_IO_DEVICE, 0);
+    _counters.deviceOutputWords.assign(NUM_IO_DEVICE, 0);
+}
+
+/** Collect the counters, the derived values are computed from the numbers of executed operations. */
+PerformanceCounters Computer::performanceCounters() const {
+    PerformanceCounters counters = _counters;
+    counters.steps = _steps;
+    counters.elapsed = _elapsed;
+    counters.memoryWrites = counters.movedWords + std::accumulate(_counters.deviceInputWords.begin(),
+                                                                  _counters.deviceInputWords.end(), int64_t{0});
+    counters.memoryReads = counters.movedWords + std::accumulate(_counters.deviceOutputWords.begin(),
+                                                                 _counters.deviceOutputWords.end(), int64_t{0});
+    int64_t jumps = 0;
+    for (int operation = 0; operation < PerformanceCounters::NUM_OPERATIONS; ++operation) {
+        const int64_t count = _operationCounts[operation];
+        if ((Instructions::ADD <= operation && operation <= Instructions::DIV) ||
+            (Instructions::LDA <= operation && operation <= Instructions::LDXN) ||
+            (Instructions::CMPA <= operation && operation <= Instructions::CMPX)) {
+            counters.memoryReads += count;
+        } else if (Instructions::STA <= operation && operation <= Instructions::STZ) {
+            counters.memoryWrites += count;
+        } else if (operation == Instructions::JBUS || operation == Instructions::JRED ||
+                   (Instructions::JMP <= operation && operation <= Instructions::JXN)) {
+            jumps += count;
+        }
+    }
+    counters.jumpsNotTaken = jumps - counters.jumpsTaken;
+    return counters;
+}
+
+}  // namespace mixal
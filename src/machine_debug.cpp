@@ -0,0 +1,135 @@
+#include <algorithm>
+#include "machine.h"
+
+/**
+ * @file
+ * @brief Breakpoints and watchpoints.
+ */
+
+namespace mixal {
+
+void Computer::setBreakpoint(const int32_t address) {
+    if (address < 0 || address >= NUM_MEMORY) {
+        throw RuntimeError(address, "Invalid location for breakpoint: " + std::to_string(address));
+    }
+    _breakpoints.set(address);
+    _breakpointConditions.erase(address);
+    _hasBreakpoints = true;
+}
+
+void Computer::setBreakpoint(const int32_t address, const BreakpointCondition& condition) {
+    setBreakpoint(address);
+    _breakpointConditions[address] = condition;
+}
+
+void Computer::clearBreakpoint(const int32_t address) {
+    if (0 <= address && address < NUM_MEMORY) {
+        _breakpoints.reset(address);
+        _breakpointConditions.erase(address);
+        _hasBreakpoints = _breakpoints.any();
+    }
+}
+
+void Computer::clearBreakpoints() {
+    _breakpoints.reset();
+    _breakpointConditions.clear();
+    _hasBreakpoints = false;
+}
+
+bool Computer::hasBreakpoint(const int32_t address) const {
+    return 0 <= address && address < NUM_MEMORY && _breakpoints.test(address);
+}
+
+void Computer::setWatchpoint(const int32_t address, const bool onRead, const bool onWrite) {
+    if (address < 0 || address >= NUM_MEMORY) {
+        throw RuntimeError(address, "Invalid location for watchpoint: " + std::to_string(address));
+    }
+    _readWatchpoints.set(address, onRead);
+    _writeWatchpoints.set(address, onWrite);
+    _hasWatchpoints = _readWatchpoints.any() || _writeWatchpoints.any();
+}
+
+void Computer::clearWatchpoint(const int32_t address) {
+    setWatchpoint(address, false, false);
+}
+
+void Computer::clearWatchpoints() {
+    _readWatchpoints.reset();
+    _writeWatchpoints.reset();
+    _hasWatchpoints = false;
+}
+
+StopInfo Computer::runUntilBreak() {
+    return run();
+}
+
+bool Computer::triggerBreakpoint(const int32_t address) {
+    const auto it = _breakpointConditions.find(address);
+    if (it == _breakpointConditions.end()) {
+        return true;
+    }
+    const auto& condition = it->second;
+    WordValue value = 0;
+    switch (condition.reg) {
+    case RegisterName::A: value = rA.value(); break;
+    case RegisterName::X: value = rX.value(); break;
+    case RegisterName::J: value = rJ.value(); break;
+    default:
+        value = rI(static_cast<int>(condition.reg) - static_cast<int>(RegisterName::I1) + 1).value();
+    }
+    return condition.check(value);
+}
+
+/** Find the first watched location the instruction is going to access.
+ *
+ * The addresses are computed with the register values before the execution.
+ * The input operation is treated as writing its whole block when it is issued.
+ */
+int32_t Computer::findWatchedAddress(const InstructionWord& instruction, StopReason* reason) {
+    if (instruction.index() > NUM_INDEX_REGISTER) {
+        return -1;
+    }
+    const int32_t address = peekIndexedAddress(instruction);
+    auto findRead = [&](const int32_t start, const int32_t length) -> int32_t {
+        for (int32_t i = std::max(0, start); i < std::min(start + length, NUM_MEMORY); ++i) {
+            if (_readWatchpoints.test(i)) {
+                *reason = StopReason::WATCH_READ;
+                return i;
+            }
+        }
+        return -1;
+    };
+    auto findWrite = [&](const int32_t start, const int32_t length) -> int32_t {
+        for (int32_t i = std::max(0, start); i < std::min(start + length, NUM_MEMORY); ++i) {
+            if (_writeWatchpoints.test(i)) {
+                *reason = StopReason::WATCH_WRITE;
+                return i;
+            }
+        }
+        return -1;
+    };
+    const auto operation = instruction.operation();
+    if ((Instructions::ADD <= operation && operation <= Instructions::DIV) ||
+        (Instructions::LDA <= operation && operation <= Instructions::LDXN) ||
+        (Instructions::CMPA <= operation && operation <= Instructions::CMPX)) {
+        return findRead(address, 1);
+    }
+    if (Instructions::STA <= operation && operation <= Instructions::STZ) {
+        return findWrite(address, 1);
+    }
+    if (operation == Instructions::MOVE) {
+        const int32_t watched = findRead(address, instruction.field());
+        return watched != -1 ? watched : findWrite(rI1.value(), instruction.field());
+    }
+    if (operation == Instructions::IN || operation == Instructions::OUT) {
+        const auto device = instruction.field() < NUM_IO_DEVICE ? findDevice(instruction.field()) : nullptr;
+        if (device == nullptr) {
+            return -1;
+        }
+        const int32_t blockSize = device->blockSize();
+        return operation == Instructions::IN ? findWrite(address, blockSize) : findRead(address, blockSize);
+    }
+    return -1;
+}
+
+}  // namespace mixal
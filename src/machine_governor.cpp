@@ -0,0 +1,93 @@
+#include <algorithm>
+#include "machine.h"
+
+/**
+ * @file
+ * @brief Resource limits for untrusted codes.
+ */
+
+namespace mixal {
+
+void Computer::setResourceLimits(const ResourceLimits& limits) {
+    _limits = limits;
+    _hasLimits = limits.printedLines >= 0 || limits.punchedCards >= 0 ||
+                 limits.tapeBlocks >= 0 || limits.diskBlocks >= 0 ||
+                 limits.movedWords >= 0 || limits.elapsed >= 0 ||
+                 limits.wallClockMilliseconds >= 0;
+    if (_limits.wallClockCheckInterval <= 0) {
+        _limits.wallClockCheckInterval = 1;
+    }
+    const auto timeout = std::chrono::milliseconds(std::max<int64_t>(0, limits.wallClockMilliseconds));
+    _deadline = std::chrono::steady_clock::now() + timeout;
+}
+
+void Computer::clearResourceLimits() {
+    setResourceLimits(ResourceLimits());
+}
+
+/** The loops without a stop reason count the steps since the last reset for the wall-clock checks. */
+void Computer::enforceResourceLimits() {
+    const auto& instruction = memory[_lineOffset];
+    if (const auto resource = checkResourceLimits(instruction, _steps); resource != ResourceKind::NONE) {
+        raiseFault(FaultCode::RESOURCE_LIMIT, instruction, static_cast<int32_t>(resource));
+    }
+}
+
+/** Find the resource that would be exceeded by executing the instruction.
+ *
+ * The counters are only updated by the instructions themselves,
+ * so the check only needs to inspect the output and MOVE operations.
+ */
+ResourceKind Computer::checkResourceLimits(const InstructionWord& instruction, const int64_t steps) {
+    if (_limits.elapsed >= 0 && _elapsed >= _limits.elapsed) {
+        return ResourceKind::ELAPSED;
+    }
+    if (_limits.wallClockMilliseconds >= 0 && steps % _limits.wallClockCheckInterval == 0 &&
+        std::chrono::steady_clock::now() >= _deadline) {
+        return ResourceKind::WALL_CLOCK;
+    }
+    auto exceeds = [](const int64_t used, const int64_t amount, const int64_t limit) {
+        return limit >= 0 && used + amount > limit;
+    };
+    switch (instruction.operation()) {
+    case Instructions::MOVE:
+        if (exceeds(_usage.movedWords, instruction.field(), _limits.movedWords)) {
+            return ResourceKind::MOVED_WORDS;
+        }
+        break;
+    case Instructions::OUT:
+        if (const auto device = instruction.field() < NUM_IO_DEVICE ? findDevice(instruction.field()) : nullptr;
+            device != nullptr) {
+            switch (device->type()) {
+            case IODeviceType::TAPE:
+                if (exceeds(_usage.tapeBlocks, 1, _limits.tapeBlocks)) {
+                    return ResourceKind::TAPE_BLOCKS;
+                }
+                break;
+            case IODeviceType::DISK:
+                if (exceeds(_usage.diskBlocks, 1, _limits.diskBlocks)) {
+                    return ResourceKind::DISK_BLOCKS;
+                }
+                break;
+            case IODeviceType::CARD_PUNCH:
+                if (exceeds(_usage.punchedCards, 1, _limits.punchedCards)) {
+                    return ResourceKind::PUNCHED_CARDS;
+                }
+                break;
+            case IODeviceType::LINE_PRINTER:
+                if (exceeds(_usage.printedLines, 1, _limits.printedLines)) {
+                    return ResourceKind::PRINTED_LINES;
+                }
+                break;
+            default:
+                break;
+            }
+        }
+        break;
+    default:
+        break;
+    }
+    return ResourceKind::NONE;
+}
+
+}  // namespace mixal
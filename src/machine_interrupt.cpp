@@ -0,0 +1,91 @@
+#include "machine.h"
+
+/**
+ * @file
+ * @brief Interrupts of device completion.
+ *
+ * The facility follows the extension of MIX in TAOCP exercise 1.4.4-18,
+ * except that the saved area is located in the ordinary memory instead of negative locations.
+ */
+
+namespace mixal {
+
+void Computer::setInterruptVector(const int32_t address) {
+    if (address >= NUM_MEMORY - INTERRUPT_SAVE_SIZE) {
+        throw RuntimeError(address, "Invalid location for interrupt vector: " + std::to_string(address));
+    }
+    _interruptVector = address < 0 ? -1 : address;
+    _controlState = false;
+    _interruptArmed.reset();
+    _interruptPending.reset();
+}
+
+void Computer::armInterrupt(const int32_t unit) {
+    if (_interruptVector >= 0) {
+        _interruptArmed.set(unit);
+    }
+}
+
+/** The busy devices are queried at the current time, which has the same distribution as polling them. */
+void Computer::checkInterrupts() {
+    if (_interruptArmed.any()) {
+        for (int32_t unit = 0; unit < NUM_IO_DEVICE; ++unit) {
+            if (_interruptArmed.test(unit)) {
+                auto device = devices[unit];
+                if (!device->busy() || device->ready(_elapsed)) {
+                    _interruptArmed.reset(unit);
+                    _interruptPending.set(unit);
+                }
+            }
+        }
+    }
+    if (!_controlState && _interruptPending.any()) {
+        for (int32_t unit = 0; unit < NUM_IO_DEVICE; ++unit) {
+            if (_interruptPending.test(unit)) {
+                _interruptPending.reset(unit);
+                enterInterrupt(unit);
+                break;
+            }
+        }
+    }
+}
+
+void Computer::enterInterrupt(const int32_t unit) {
+    auto saved = memory + _interruptVector;
+    saved[0] = rA;
+    saved[1] = rX;
+    for (int i = 1; i <= NUM_INDEX_REGISTER; ++i) {
+        const auto& index = indexRegister(i);
+        saved[1 + i].set(index.negative, 0, 0, 0, index.byte1, index.byte2);
+    }
+    saved[8].set(rJ.negative, 0, 0, 0, rJ.byte1, rJ.byte2);
+    saved[9].set(false, static_cast<uint16_t>(_lineOffset), static_cast<uint8_t>(unit),
+                 static_cast<uint8_t>(overflow), static_cast<uint8_t>(static_cast<int>(comparison) + 1));
+    _controlState = true;
+    _lineOffset = _interruptVector + INTERRUPT_SAVE_SIZE;
+    _memoryHashDirty = true;
+}
+
+/** Restore the state saved by the interrupt.
+ *
+ * INT outside of a handler raises a fault.
+ */
+void Computer::executeINT() {
+    if (!_controlState) {
+        raiseFault(FaultCode::INT_OUTSIDE_HANDLER, memory[_lineOffset]);
+        return;
+    }
+    const auto saved = memory + _interruptVector;
+    rA = saved[0];
+    rX = saved[1];
+    for (int i = 1; i <= NUM_INDEX_REGISTER; ++i) {
+        indexRegister(i).set(saved[1 + i].negative, saved[1 + i].byte4, saved[1 + i].byte5);
+    }
+    rJ.set(saved[8].negative, saved[8].byte4, saved[8].byte5);
+    overflow = saved[9].byte4 != 0;
+    comparison = static_cast<ComparisonIndicator>(static_cast<int>(saved[9].byte5) - 1);
+    _controlState = false;
+    _lineOffset = saved[9].bytes12() - 1;
+}
+
+}  // namespace mixal
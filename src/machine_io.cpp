@@ -1,4 +1,8 @@
+#include <algorithm>
+#include <array>
 #include <iostream>
+#include <limits>
+#include <memory>
 #include "machine.h"
 
 /**
@@ -8,7 +12,86 @@
 
 namespace mixal {
 
+namespace {
+
+/** Maximum number of idle devices kept for each unit in one thread. */
+constexpr size_t MAX_POOLED_DEVICES = 64;
+
+/** Whether the pool of the current thread has been destroyed at the exit of the thread. */
+thread_local bool devicePoolDestroyed = false;
+
+/** Devices released by the machines in the current thread, indexed by the unit. */
+struct DevicePool {
+    std::array<std::vector<std::unique_ptr<IODevice>>, Computer::NUM_IO_DEVICE> devices;
+
+    ~DevicePool() { devicePoolDestroyed = true; }
+};
+
+/** Get the pool of the current thread, or null if it is no longer available. */
+DevicePool* getDevicePool() {
+    if (devicePoolDestroyed) {
+        return nullptr;
+    }
+    thread_local DevicePool pool;
+    return &pool;
+}
+
+}  // namespace
+
+void Computer::releaseDevices() {
+    for (int i = 0; i < NUM_IO_DEVICE; ++i) {
+        if (devices[i] == nullptr) {
+            continue;
+        }
+        std::unique_ptr<IODevice> device(devices[i]);
+        devices[i] = nullptr;
+        if (_deviceFactories[i] != nullptr) {
+            continue;
+        }
+        auto pool = getDevicePool();
+        if (pool != nullptr && pool->devices[i].size() < MAX_POOLED_DEVICES) {
+            device->reset();
+            pool->devices[i].push_back(std::move(device));
+        }
+    }
+}
+
 IODevice* Computer::getDevice(const int32_t index) {
+    const auto device = findDevice(index);
+    if (device == nullptr) {
+        throw RuntimeError(_lineOffset, "The device factory returns null: " + std::to_string(index));
+    }
+    return device;
+}
+
+IODevice* Computer::instructionDevice(const InstructionWord& instruction) {
+    const int32_t unit = instruction.field();
+    if (unit >= NUM_IO_DEVICE) {
+        raiseFault(FaultCode::INVALID_DEVICE, instruction, unit);
+        return nullptr;
+    }
+    const auto device = findDevice(unit);
+    if (device == nullptr) {
+        raiseFault(FaultCode::NULL_DEVICE, instruction, unit);
+    }
+    return device;
+}
+
+IODevice* Computer::findDevice(const int32_t index) {
+    if (devices[index] == nullptr && _deviceFactories[index] != nullptr) {
+        auto device = _deviceFactories[index]();
+        if (device == nullptr) {
+            return nullptr;
+        }
+        devices[index] = device.release();
+    }
+    if (devices[index] == nullptr) {
+        auto pool = getDevicePool();
+        if (pool != nullptr && !pool->devices[index].empty()) {
+            devices[index] = pool->devices[index].back().release();
+            pool->devices[index].pop_back();
+        }
+    }
     if (devices[index] == nullptr) {
         switch (index) {
         case 0: case 1: case 2: case 3:
@@ -39,9 +122,97 @@ IODevice* Computer::getDevice(const int32_t index) {
     return devices[index];
 }
 
+void Computer::registerDevice(const int32_t unit, DeviceFactory factory) {
+    if (unit < 0 || unit >= NUM_IO_DEVICE) {
+        throw RuntimeError(_lineOffset, "Invalid device: " + std::to_string(unit));
+    }
+    if (devices[unit] != nullptr) {
+        if (devices[unit]->busy()) {
+            waitDevice(devices[unit]);
+        }
+        devices[unit]->flush();
+        delete devices[unit];
+        devices[unit] = nullptr;
+    }
+    _deviceFactories[unit] = std::move(factory);
+}
+
+bool Computer::hasRegisteredDevice(const int32_t unit) const {
+    return 0 <= unit && unit < NUM_IO_DEVICE && _deviceFactories[unit] != nullptr;
+}
+
+void Computer::mapDeviceFile(const int32_t device, const std::string& path) {
+    if (device < 0 || device >= NUM_IO_DEVICE) {
+        throw RuntimeError(_lineOffset, "Invalid device: " + std::to_string(device));
+    }
+    const auto type = getDevice(device)->type();
+    if (type != IODeviceType::TAPE && type != IODeviceType::DISK) {
+        throw RuntimeError(_lineOffset, "Only tapes and disks can be mapped to files: " + std::to_string(device));
+    }
+    auto storage = static_cast<IODeviceStorage*>(getDevice(device));
+    if (storage->busy()) {
+        waitDevice(storage);
+    }
+    storage->mapFile(path);
+}
+
+void Computer::unmapDeviceFile(const int32_t device) {
+    if (device < 0 || device >= NUM_IO_DEVICE || devices[device] == nullptr) {
+        return;
+    }
+    const auto type = devices[device]->type();
+    if (type == IODeviceType::TAPE || type == IODeviceType::DISK) {
+        auto storage = static_cast<IODeviceStorage*>(devices[device]);
+        if (storage->busy()) {
+            waitDevice(storage);
+        }
+        storage->unmapFile();
+    }
+}
+
+void Computer::setDeviceSource(const int32_t device, std::shared_ptr<BlockSource> source) {
+    if (device < 0 || device >= NUM_IO_DEVICE) {
+        throw RuntimeError(_lineOffset, "Invalid device: " + std::to_string(device));
+    }
+    auto reader = dynamic_cast<IODeviceSeqReader*>(getDevice(device));
+    if (reader == nullptr) {
+        throw RuntimeError(_lineOffset, "Device is not a sequential input device: " + std::to_string(device));
+    }
+    if (reader->busy()) {
+        waitDevice(reader);
+    }
+    reader->setSource(std::move(source));
+}
+
+void Computer::setDeviceSink(const int32_t device, std::shared_ptr<BlockSink> sink) {
+    if (device < 0 || device >= NUM_IO_DEVICE) {
+        throw RuntimeError(_lineOffset, "Invalid device: " + std::to_string(device));
+    }
+    auto writer = dynamic_cast<IODeviceSeqWriter*>(getDevice(device));
+    if (writer == nullptr) {
+        throw RuntimeError(_lineOffset, "Device is not a sequential output device: " + std::to_string(device));
+    }
+    if (writer->busy()) {
+        waitDevice(writer);
+    }
+    writer->setSink(std::move(sink));
+}
+
 void Computer::waitDevice(IODevice* device) {
-    while (!device->ready(this->_elapsed)) {
-        ++this->_elapsed;
+    const int64_t start = this->_elapsed;
+    this->_elapsed = device->pollUntilReady(this->_elapsed, 1);
+    if (this->_elapsed > start || _trace.enabled()) {
+        const auto it = std::find(devices.begin(), devices.end(), device);
+        if (it != devices.end()) {
+            const auto unit = static_cast<int32_t>(it - devices.begin());
+            _counters.deviceWaitCycles[unit] += this->_elapsed - start;
+            if (_trace.enabled()) {
+                if (this->_elapsed > start) {
+                    _trace.record({start, this->_elapsed - start, unit, DeviceEventType::WAIT, 0});
+                }
+                traceCompletion(unit);
+            }
+        }
     }
 }
 
@@ -49,6 +220,7 @@ void Computer::waitDevices() {
     for (int i = 0; i < NUM_IO_DEVICE; ++i) {
         if (devices[i] != nullptr) {
             waitDevice(devices[i]);
+            devices[i]->flush();
         }
     }
 }
@@ -62,8 +234,40 @@ ComputerWord& Computer::getDeviceWordAt(const int32_t device, const int32_t inde
  * The field value indicates the device.
  */
 void Computer::executeJBUS(const InstructionWord& instruction) {
-    auto device = getDevice(instruction.field());
-    if (!device->ready(this->_elapsed)) {
+    auto device = instructionDevice(instruction);
+    if (device == nullptr) {
+        return;
+    }
+    if (_idleFastForward && !_hasBreakpoints && _interruptVector < 0) {
+        const int32_t address = getIndexedAddress(instruction);
+        if (faulted()) {
+            return;
+        }
+        if (address == _lineOffset) {
+            const int64_t cost = Instructions::getCost(Instructions::JBUS, instruction.field());
+            const int64_t maxPolls = pollBudget(cost, 1);
+            const int64_t failures = skipPolling(instruction.field(), device, cost, maxPolls);
+            // When the budget runs out first, this instruction is the last poll and jumps to itself.
+            const int64_t skipped = failures < maxPolls ? failures : failures - 1;
+            if (skipped > 0) {
+                rJ.set(_lineOffset + 1);
+                countSkipped(instruction, skipped);
+                countPolling(instruction.field(), skipped * cost);
+                _counters.jumpsTaken += skipped;
+            }
+            if (failures == maxPolls) {
+                countPolling(instruction.field(), cost);
+                this->executeJMP(instruction);
+            }
+            return;
+        }
+    }
+    const bool ready = device->ready(this->_elapsed);
+    if (_trace.enabled()) {
+        traceCompletion(instruction.field());
+    }
+    if (!ready) {
+        countPolling(instruction.field(), Instructions::getCost(Instructions::JBUS, instruction.field()));
         this->executeJMP(instruction);
     }
 }
@@ -73,46 +277,98 @@ void Computer::executeJBUS(const InstructionWord& instruction) {
  * The field value indicates the device.
  */
 void Computer::executeIOC(const InstructionWord& instruction) {
-    auto device = getDevice(instruction.field());
+    auto device = instructionDevice(instruction);
+    if (device == nullptr) {
+        return;
+    }
+    if (_trace.enabled()) {
+        _trace.record({this->_elapsed, 0, instruction.field(), DeviceEventType::ISSUE, Instructions::IOC});
+    }
     waitDevice(device);
     if (device->type() == IODeviceType::DISK) {
         device->control(rX.value());
     } else {
         int32_t address = getIndexedAddress(instruction);
+        if (faulted()) {
+            return;
+        }
         device->control(address);
     }
+    if (_trace.enabled()) {
+        traceStart(instruction.field(), Instructions::IOC);
+    }
+    armInterrupt(instruction.field());
 }
 
 /** Read a block from the device.
  * 
  * The field value indicates the device.
  * 
- * @throw mixal::Runtime When the device cannot be read.
+ * A device that cannot be read raises a fault.
  */
 void Computer::executeIN(const InstructionWord& instruction) {
-    auto device = getDevice(instruction.field());
+    auto device = instructionDevice(instruction);
+    if (device == nullptr) {
+        return;
+    }
     if (!device->allowRead()) {
-        throw RuntimeError(_lineOffset, "Device does not support read: " + std::to_string(instruction.field()));
+        raiseFault(FaultCode::READ_NOT_SUPPORTED, instruction, instruction.field());
+        return;
+    }
+    if (_trace.enabled()) {
+        _trace.record({this->_elapsed, 0, instruction.field(), DeviceEventType::ISSUE, Instructions::IN});
     }
     waitDevice(device);
     int32_t address = getIndexedAddress(instruction, true);
+    checkBlockRange(instruction, address, device->blockSize());
+    if (faulted()) {
+        return;
+    }
     device->read(memory, address);
+    _counters.deviceInputWords[instruction.field()] += device->blockSize();
+    if (_trace.enabled()) {
+        traceStart(instruction.field(), Instructions::IN);
+    }
+    armInterrupt(instruction.field());
 }
 
 /** Write a block to the device.
  * 
  * The field value indicates the device.
  * 
- * @throw mixal::Runtime When the device cannot be written.
+ * A device that cannot be written raises a fault.
  */
 void Computer::executeOUT(const InstructionWord& instruction) {
-    auto device = getDevice(instruction.field());
+    auto device = instructionDevice(instruction);
+    if (device == nullptr) {
+        return;
+    }
     if (!device->allowWrite()) {
-        throw RuntimeError(_lineOffset, "Device does not support write: " + std::to_string(instruction.field()));
+        raiseFault(FaultCode::WRITE_NOT_SUPPORTED, instruction, instruction.field());
+        return;
+    }
+    if (_trace.enabled()) {
+        _trace.record({this->_elapsed, 0, instruction.field(), DeviceEventType::ISSUE, Instructions::OUT});
     }
     waitDevice(device);
     int32_t address = getIndexedAddress(instruction, true);
+    checkBlockRange(instruction, address, device->blockSize());
+    if (faulted()) {
+        return;
+    }
     device->write(memory, address);
+    _counters.deviceOutputWords[instruction.field()] += device->blockSize();
+    if (_trace.enabled()) {
+        traceStart(instruction.field(), Instructions::OUT);
+    }
+    armInterrupt(instruction.field());
+    switch (device->type()) {
+    case IODeviceType::TAPE: ++_usage.tapeBlocks; break;
+    case IODeviceType::DISK: ++_usage.diskBlocks; break;
+    case IODeviceType::CARD_PUNCH: ++_usage.punchedCards; break;
+    case IODeviceType::LINE_PRINTER: ++_usage.printedLines; break;
+    default: break;
+    }
 }
 
 /** Jump when the device is ready.
@@ -120,9 +376,97 @@ void Computer::executeOUT(const InstructionWord& instruction) {
  * The field value indicates the device.
  */
 void Computer::executeJRED(const InstructionWord& instruction) {
-    auto device = getDevice(instruction.field());
-    if (device->ready(this->_elapsed)) {
+    auto device = instructionDevice(instruction);
+    if (device == nullptr) {
+        return;
+    }
+    if (_idleFastForward && !_hasBreakpoints && _interruptVector < 0 && _lineOffset + 1 < NUM_MEMORY) {
+        const auto& next = memory[_lineOffset + 1];
+        if (next.operation() == Instructions::JMP && next.field() == 0 && next.index() == 0 &&
+            next.addressValue() == _lineOffset) {
+            const int64_t pollCost = Instructions::getCost(Instructions::JRED, instruction.field());
+            const int64_t cost = pollCost + Instructions::getCost(Instructions::JMP, 0);
+            const int64_t maxPolls = pollBudget(cost, 2);
+            const int64_t failures = skipPolling(instruction.field(), device, cost, maxPolls);
+            // When the budget runs out first, this instruction is the last poll and falls through to the JMP.
+            const int64_t skipped = failures < maxPolls ? failures : failures - 1;
+            if (skipped > 0) {
+                rJ.set(_lineOffset + 2);
+                countSkipped(instruction, skipped);
+                countSkipped(next, skipped);
+                countPolling(instruction.field(), skipped * pollCost);
+                _counters.jumpsTaken += skipped;
+            }
+            if (failures < maxPolls) {
+                this->executeJMP(instruction);
+            } else {
+                countPolling(instruction.field(), pollCost);
+            }
+            return;
+        }
+    }
+    const bool ready = device->ready(this->_elapsed);
+    if (_trace.enabled()) {
+        traceCompletion(instruction.field());
+    }
+    if (ready) {
         this->executeJMP(instruction);
+    } else {
+        countPolling(instruction.field(), Instructions::getCost(Instructions::JRED, instruction.field()));
+    }
+}
+
+/** The whole block is validated once so that the devices can copy it in bulk.
+ *
+ * A block that exceeds the memory raises a fault.
+ */
+void Computer::checkBlockRange(const InstructionWord& instruction, const int32_t address, const int32_t blockSize) {
+    if (address + blockSize > NUM_MEMORY) {
+        raiseFault(FaultCode::BLOCK_OUT_OF_MEMORY, instruction, address, blockSize);
+    }
+}
+
+/** The run stops before an instruction that starts at or after the elapsed budget or the elapsed limit,
+ * or that exceeds the step budget, so the polls after it are never executed.
+ */
+int64_t Computer::pollBudget(const int64_t interval, const int64_t stepsPerPoll) const {
+    constexpr int64_t UNLIMITED = std::numeric_limits<int64_t>::max();
+    int64_t elapsedLimit = _elapsedBudget;
+    if (_limits.elapsed >= 0) {
+        elapsedLimit = std::min(elapsedLimit, _limits.elapsed);
+    }
+    int64_t polls = UNLIMITED;
+    if (elapsedLimit != UNLIMITED) {
+        polls = std::max<int64_t>(1, (elapsedLimit - _elapsed + interval - 1) / interval);
+    }
+    if (_stepBudget != UNLIMITED) {
+        polls = std::min(polls, std::max<int64_t>(1, (_stepBudget - _steps + stepsPerPoll - 1) / stepsPerPoll));
+    }
+    return polls;
+}
+
+/** The elapsed time is moved to the poll that finds the device ready. */
+int64_t Computer::skipPolling(const int32_t unit, IODevice* device, const int64_t interval, const int64_t maxPolls) {
+    const int64_t start = _elapsed;
+    const int64_t limit = maxPolls > (std::numeric_limits<int64_t>::max() - start) / interval ?
+                          std::numeric_limits<int64_t>::max() : start + maxPolls * interval;
+    const int64_t polled = device->pollUntilReady(_elapsed, interval, limit);
+    const int64_t failures = std::min((polled - start) / interval, maxPolls);
+    _elapsed = failures == maxPolls ? start + (maxPolls - 1) * interval : polled;
+    if (_trace.enabled()) {
+        if (_elapsed > start) {
+            _trace.record({start, _elapsed - start, unit, DeviceEventType::POLL, 0});
+        }
+        traceCompletion(unit);
+    }
+    return failures;
+}
+
+void Computer::countSkipped(const InstructionWord& instruction, const int64_t times) {
+    _steps += times;
+    _operationCounts[instruction.operation()] += times;
+    if (!_counters.instructions.empty()) {
+        _counters.instructions[instruction.operation() * PerformanceCounters::NUM_FIELDS + instruction.field()] += times;
     }
 }
 
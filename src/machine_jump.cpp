@@ -14,14 +14,22 @@ namespace mixal {
  */
 void Computer::executeJMP(const InstructionWord& instruction) {
     const int32_t address = getIndexedAddress(instruction, true);
+    if (faulted()) {
+        return;
+    }
     rJ.set(_lineOffset + 1);
     _lineOffset = address - 1;
+    ++_counters.jumpsTaken;
 }
 
 /** Jump without updating rJ. */
 void Computer::executeJSJ(const InstructionWord& instruction) {
     const int32_t address = getIndexedAddress(instruction, true);
+    if (faulted()) {
+        return;
+    }
     _lineOffset = address - 1;
+    ++_counters.jumpsTaken;
 }
 
 /** Jump when overflow.
@@ -97,8 +105,12 @@ void Computer::executeJGE(const InstructionWord& instruction) {
 void Computer::executeJNE(const InstructionWord& instruction) {
     if (comparison != ComparisonIndicator::EQUAL) {
         const int32_t address = getIndexedAddress(instruction, true);
+        if (faulted()) {
+            return;
+        }
         rJ.set(_lineOffset + 1);
         _lineOffset = address - 1;
+        ++_counters.jumpsTaken;
     }
 }
 
@@ -157,7 +169,7 @@ void Computer::executeJNP(const InstructionWord& instruction, Register5* reg) {
 /** Jump when rI is negative. */
 void Computer::executeJiN(const InstructionWord& instruction) {
     const int registerIndex = instruction.operation() - Instructions::J1N + 1;
-    const auto& rIi = rI(registerIndex);
+    const auto& rIi = indexRegister(registerIndex);
     if (rIi.value() < 0) {
         this->executeJMP(instruction);
     }
@@ -166,7 +178,7 @@ void Computer::executeJiN(const InstructionWord& instruction) {
 /** Jump when rI is zero. */
 void Computer::executeJiZ(const InstructionWord& instruction) {
     const int registerIndex = instruction.operation() - Instructions::J1N + 1;
-    const auto& rIi = rI(registerIndex);
+    const auto& rIi = indexRegister(registerIndex);
     if (rIi.value() == 0) {
         this->executeJMP(instruction);
     }
@@ -175,7 +187,7 @@ void Computer::executeJiZ(const InstructionWord& instruction) {
 /** Jump when rI is positive. */
 void Computer::executeJiP(const InstructionWord& instruction) {
     const int registerIndex = instruction.operation() - Instructions::J1N + 1;
-    const auto& rIi = rI(registerIndex);
+    const auto& rIi = indexRegister(registerIndex);
     if (rIi.value() > 0) {
         this->executeJMP(instruction);
     }
@@ -184,7 +196,7 @@ void Computer::executeJiP(const InstructionWord& instruction) {
 /** Jump when rI is non-negative. */
 void Computer::executeJiNN(const InstructionWord& instruction) {
     const int registerIndex = instruction.operation() - Instructions::J1N + 1;
-    const auto& rIi = rI(registerIndex);
+    const auto& rIi = indexRegister(registerIndex);
     if (rIi.value() >= 0) {
         this->executeJMP(instruction);
     }
@@ -193,7 +205,7 @@ void Computer::executeJiNN(const InstructionWord& instruction) {
 /** Jump when rI is not zero. */
 void Computer::executeJiNZ(const InstructionWord& instruction) {
     const int registerIndex = instruction.operation() - Instructions::J1N + 1;
-    const auto& rIi = rI(registerIndex);
+    const auto& rIi = indexRegister(registerIndex);
     if (rIi.value() != 0) {
         this->executeJMP(instruction);
     }
@@ -202,7 +214,7 @@ void Computer::executeJiNZ(const InstructionWord& instruction) {
 /** Jump when rI is non-positive. */
 void Computer::executeJiNP(const InstructionWord& instruction) {
     const int registerIndex = instruction.operation() - Instructions::J1N + 1;
-    const auto& rIi = rI(registerIndex);
+    const auto& rIi = indexRegister(registerIndex);
     if (rIi.value() <= 0) {
         this->executeJMP(instruction);
     }
@@ -0,0 +1,156 @@
+#include <algorithm>
+#include <cstdlib>
+#include "machine.h"
+
+/**
+ * @file
+ * @brief Detection of non-terminating loops.
+ *
+ * The memory is hashed incrementally in the style of Zobrist hashing:
+ * the hash is the XOR of the hashes of (address, word) pairs,
+ * so that a write only needs to remove the old word and add the new one.
+ */
+
+namespace mixal {
+
+namespace {
+
+uint64_t mixHash(uint64_t x) {
+    x += 0x9e3779b97f4a7c15ULL;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
+
+uint64_t packWord(const ComputerWord& word) {
+    return static_cast<uint64_t>(word.negative) * WordFormat::power(5) + static_cast<uint64_t>(std::abs(word.value()));
+}
+
+uint64_t packRegister(const Register2& reg) {
+    return static_cast<uint64_t>(reg.negative) * WordFormat::power(2) + static_cast<uint64_t>(reg.bytes12());
+}
+
+uint64_t hashWord(const int32_t address, const ComputerWord& word) {
+    return mixHash((static_cast<uint64_t>(address) << 32) ^ packWord(word));
+}
+
+}  // namespace
+
+int32_t Computer::peekIndexedAddress(const InstructionWord& instruction) const {
+    int32_t offset = 0;
+    switch (instruction.index()) {
+    case 0: break;
+    case 1: offset = rI1.value(); break;
+    case 2: offset = rI2.value(); break;
+    case 3: offset = rI3.value(); break;
+    case 4: offset = rI4.value(); break;
+    case 5: offset = rI5.value(); break;
+    case 6: offset = rI6.value(); break;
+    default: return -1;
+    }
+    return static_cast<int32_t>(instruction.addressValue()) + offset;
+}
+
+void Computer::resetLoopDetection() {
+    clearLoopSamples();
+    _memoryHashDirty = true;
+}
+
+void Computer::clearLoopSamples() {
+    _loopStates.fill(0);
+    _loopAnchor = 0;
+    _loopAnchorPower = 1;
+    _loopAnchorDistance = 0;
+}
+
+/** Remove the words that are going to be written by the instruction from the memory hash.
+ *
+ * The IO operations clear the sampled states since the results depend on the devices.
+ */
+void Computer::beforeLoopDetection(const InstructionWord& instruction, int32_t* writeStart, int32_t* writeLength) {
+    const auto operation = instruction.operation();
+    int32_t start = 0, stop = 0;
+    if (Instructions::STA <= operation && operation <= Instructions::STZ) {
+        start = peekIndexedAddress(instruction);
+        stop = start + 1;
+    } else if (operation == Instructions::MOVE) {
+        start = rI1.value();
+        stop = start + instruction.field();
+    } else if (Instructions::JBUS <= operation && operation <= Instructions::JRED) {
+        clearLoopSamples();
+        if (operation == Instructions::IN) {
+            _memoryHashDirty = true;
+        }
+        return;
+    }
+    start = std::max(0, start);
+    stop = std::min(stop, static_cast<int32_t>(NUM_MEMORY));
+    for (int32_t i = start; i < stop; ++i) {
+        _memoryHash ^= hashWord(i, memory[i]);
+    }
+    *writeStart = start;
+    *writeLength = std::max(0, stop - start);
+}
+
+void Computer::hashMemory(const int32_t start, const int32_t length) {
+    for (int32_t i = start; i < start + length; ++i) {
+        _memoryHash ^= hashWord(i, memory[i]);
+    }
+}
+
+bool Computer::detectLoop() {
+    if (_memoryHashDirty) {
+        for (const auto& device : devices) {
+            if (device != nullptr && device->busy()) {
+                clearLoopSamples();
+                return false;
+            }
+        }
+        _memoryHash = 0;
+        hashMemory(0, NUM_MEMORY);
+        _memoryHashDirty = false;
+    }
+    uint64_t state = _memoryHash;
+    auto combine = [&state](const uint64_t value) { state = mixHash(state ^ value); };
+    combine(packWord(rA));
+    combine(packWord(rX));
+    combine(packRegister(rI1));
+    combine(packRegister(rI2));
+    combine(packRegister(rI3));
+    combine(packRegister(rI4));
+    combine(packRegister(rI5));
+    combine(packRegister(rI6));
+    combine(packRegister(rJ));
+    combine((static_cast<uint64_t>(overflow) << 2) | static_cast<uint64_t>(static_cast<int>(comparison) + 1));
+    combine(static_cast<uint64_t>(_lineOffset));
+    if (state == 0) {
+        state = 1;
+    }
+    if (state == _loopAnchor) {
+        return true;
+    }
+    // Brent's method: the anchor catches the cycles that are too long for the recent samples.
+    if (++_loopAnchorDistance == _loopAnchorPower) {
+        _loopAnchor = state;
+        _loopAnchorPower *= 2;
+        _loopAnchorDistance = 0;
+    }
+    const auto set = _loopStates.begin() + static_cast<int>(state % NUM_LOOP_SETS) * NUM_LOOP_WAYS;
+    if (std::find(set, set + NUM_LOOP_WAYS, state) != set + NUM_LOOP_WAYS) {
+        return true;
+    }
+    std::copy_backward(set, set + NUM_LOOP_WAYS - 1, set + NUM_LOOP_WAYS);
+    *set = state;
+    return false;
+}
+
+bool Computer::executeDetectingLoop(const InstructionWord& instruction) {
+    const int32_t line = _lineOffset;
+    int32_t writeStart = 0, writeLength = 0;
+    beforeLoopDetection(instruction, &writeStart, &writeLength);
+    executeInstruction(instruction);
+    hashMemory(writeStart, writeLength);
+    return !faulted() && _lineOffset <= line && !interruptExpected() && detectLoop();
+}
+
+}  // namespace mixal
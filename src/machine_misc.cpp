@@ -1,4 +1,7 @@
 #include <iostream>
+#include <algorithm>
+#include <array>
+#include <tuple>
 #include "machine.h"
 
 /**
@@ -11,6 +14,9 @@ namespace mixal {
 /** Shift left rA padded with zeros. */
 void Computer::executeSLA(const InstructionWord& instruction) {
     const int32_t address = getIndexedAddress(instruction);
+    if (faulted()) {
+        return;
+    }
     const int32_t shift = (address + 10000) % 5;
     if (shift) {
         for (int i = 1; i <= (5 - shift); ++i) {
@@ -25,6 +31,9 @@ void Computer::executeSLA(const InstructionWord& instruction) {
 /** Shift right rA padded with zeros. */
 void Computer::executeSRA(const InstructionWord& instruction) {
     const int32_t address = getIndexedAddress(instruction);
+    if (faulted()) {
+        return;
+    }
     const int32_t shift = (address + 10000) % 5;
     if (shift) {
         for (int i = 5; i > shift; --i) {
@@ -39,68 +48,95 @@ void Computer::executeSRA(const InstructionWord& instruction) {
 /** Shift left rA and rX padded with zeros. */
 void Computer::executeSLAX(const InstructionWord& instruction) {
     const int32_t address = getIndexedAddress(instruction);
-    const int32_t shift = (address + 10000) % 10;
-    if (shift) {
-        for (int i = 1; i <= (10 - shift); ++i) {
-            setAX(i, getAX(i + shift));
-        }
-        for (int i = 11 - shift; i <= 10; ++i) {
-            setAX(i, 0);
-        }
+    if (faulted()) {
+        return;
+    }
+    if (const int32_t shift = (address + 10000) % 10; shift) {
+        shiftAX(shift, false);
     }
 }
 
 /** Shift right rA and rX padded with zeros. */
 void Computer::executeSRAX(const InstructionWord& instruction) {
     const int32_t address = getIndexedAddress(instruction);
-    const int32_t shift = (address + 10000) % 10;
-    if (shift) {
-        for (int i = 10; i > shift; --i) {
-            setAX(i, getAX(i - shift));
-        }
-        for (int i = shift; i > 0; --i) {
-            setAX(i, 0);
-        }
+    if (faulted()) {
+        return;
+    }
+    if (const int32_t shift = (address + 10000) % 10; shift) {
+        shiftAX(-shift, false);
     }
 }
 
 /** Shift left rA and rX circularly. */
 void Computer::executeSLC(const InstructionWord& instruction) {
     const int32_t address = getIndexedAddress(instruction);
-    const int32_t shift = (address + 10000) % 10;
-    if (shift) {
-        auto swap = [&](int start, int stop) {
-            const int mid = start + (stop - start) / 2;
-            for (int i = start; i < mid; ++i) {
-                const int opposite = stop - 1 - (i - start);
-                const uint8_t temp = getAX(i);
-                setAX(i, getAX(opposite));
-                setAX(opposite, temp);
-            }
-        };
-        swap(1, shift + 1);
-        swap(shift + 1, 11);
-        swap(1, 11);
+    if (faulted()) {
+        return;
+    }
+    if (const int32_t shift = (address + 10000) % 10; shift) {
+        shiftAX(shift, true);
     }
 }
 
 /** Shift right rA and rX circularly. */
 void Computer::executeSRC(const InstructionWord& instruction) {
     const int32_t address = getIndexedAddress(instruction);
-    const int32_t shift = (address + 10000) % 10;
-    if (shift) {
-        auto swap = [&](int start, int stop) {
-            const int mid = start + (stop - start) / 2;
-            for (int i = start; i < mid; ++i) {
-                const int opposite = stop - 1 - (i - start);
-                const uint8_t temp = getAX(i);
-                setAX(i, getAX(opposite));
-                setAX(opposite, temp);
-            }
-        };
-        swap(1, 11 - shift);
-        swap(11 - shift, 11);
-        swap(1, 11);
+    if (faulted()) {
+        return;
+    }
+    if (const int32_t shift = (address + 10000) % 10; shift) {
+        shiftAX(-shift, true);
+    }
+}
+
+uint64_t Computer::unitsAX() const {
+    uint64_t units = 0;
+    for (const uint8_t byte : {rA.byte1, rA.byte2, rA.byte3, rA.byte4, rA.byte5,
+                               rX.byte1, rX.byte2, rX.byte3, rX.byte4, rX.byte5}) {
+        units = WordFormat::combine<uint64_t>(units, byte);
+    }
+    return units;
+}
+
+void Computer::setUnitsAX(const uint64_t units) {
+    rA.byte1 = WordFormat::byteAt(units, 9);
+    rA.byte2 = WordFormat::byteAt(units, 8);
+    rA.byte3 = WordFormat::byteAt(units, 7);
+    rA.byte4 = WordFormat::byteAt(units, 6);
+    rA.byte5 = WordFormat::byteAt(units, 5);
+    rX.byte1 = WordFormat::byteAt(units, 4);
+    rX.byte2 = WordFormat::byteAt(units, 3);
+    rX.byte3 = WordFormat::byteAt(units, 2);
+    rX.byte4 = WordFormat::byteAt(units, 1);
+    rX.byte5 = WordFormat::byteAt(units, 0);
+}
+
+/** Binary bytes are shifted as one 60-bit number, the others as an array of bytes. */
+void Computer::shiftAX(const int32_t amount, const bool circular) {
+    if constexpr (WordFormat::BINARY) {
+        constexpr int TOTAL_BITS = 10 * WordFormat::BITS;
+        constexpr uint64_t MASK = (uint64_t{1} << TOTAL_BITS) - 1;
+        const uint64_t units = unitsAX();
+        const int bits = (amount > 0 ? amount : -amount) * WordFormat::BITS;
+        uint64_t shifted = amount > 0 ? units << bits : units >> bits;
+        if (circular) {
+            shifted |= amount > 0 ? units >> (TOTAL_BITS - bits) : units << (TOTAL_BITS - bits);
+        }
+        setUnitsAX(shifted & MASK);
+    } else {
+        std::array<uint8_t, 10> bytes = {rA.byte1, rA.byte2, rA.byte3, rA.byte4, rA.byte5,
+                                         rX.byte1, rX.byte2, rX.byte3, rX.byte4, rX.byte5};
+        const int32_t shift = amount > 0 ? amount : -amount;
+        if (circular) {
+            std::rotate(bytes.begin(), amount > 0 ? bytes.begin() + shift : bytes.end() - shift, bytes.end());
+        } else if (amount > 0) {
+            std::fill(std::copy(bytes.begin() + shift, bytes.end(), bytes.begin()), bytes.end(), 0);
+        } else {
+            std::copy_backward(bytes.begin(), bytes.end() - shift, bytes.end());
+            std::fill_n(bytes.begin(), shift, 0);
+        }
+        std::tie(rA.byte1, rA.byte2, rA.byte3, rA.byte4, rA.byte5) = std::tie(bytes[0], bytes[1], bytes[2], bytes[3], bytes[4]);
+        std::tie(rX.byte1, rX.byte2, rX.byte3, rX.byte4, rX.byte5) = std::tie(bytes[5], bytes[6], bytes[7], bytes[8], bytes[9]);
     }
 }
 
@@ -108,20 +144,32 @@ void Computer::executeSRC(const InstructionWord& instruction) {
  *
  * The field value means the number of words to be moved.
  * Nothing happens if the address is out of range.
+ * The words are moved one by one from the lowest address, so a target overlapping the end of the origin
+ * repeats the leading words. It is copied in chunks no longer than the distance between the two.
  */
 void Computer::executeMOVE(const InstructionWord& instruction) {
     const int32_t originAddress = getIndexedAddress(instruction);
+    if (faulted()) {
+        return;
+    }
     const int32_t targetAddress = rI1.value();
     const uint8_t amount = instruction.field();
-    for (uint8_t i = 0; i < amount; ++i) {
-        const int32_t target = targetAddress + i;
-        const int32_t origin = originAddress + i;
-        if (origin < 0 || origin >= NUM_MEMORY || target < 0 || target >= NUM_MEMORY) {
-            continue;
+    const int32_t first = std::max({0, -originAddress, -targetAddress});
+    const int32_t last = std::min({static_cast<int32_t>(amount), NUM_MEMORY - originAddress, NUM_MEMORY - targetAddress});
+    const int32_t distance = targetAddress - originAddress;
+    if (first < last && distance != 0) {
+        if (distance < 0 || distance >= last - first) {
+            std::copy(memory + originAddress + first, memory + originAddress + last, memory + targetAddress + first);
+        } else {
+            for (int32_t start = first; start < last; start += distance) {
+                const int32_t length = std::min(distance, last - start);
+                std::copy_n(memory + originAddress + start, length, memory + targetAddress + start);
+            }
         }
-        memory[target] = memory[origin];
     }
     rI1.set(targetAddress + amount);
+    _usage.movedWords += amount;
+    _counters.movedWords += amount;
 }
 
 }  // namespace mixal
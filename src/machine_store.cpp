@@ -11,14 +11,20 @@ namespace mixal {
 /** Store the value in rA or rX to memory. */
 void Computer::executeST(const InstructionWord& instruction, Register5* reg) {
     const int address = getIndexedAddress(instruction, true);
+    if (faulted()) {
+        return;
+    }
     copyFromRegister5(instruction, *reg, &memory[address]);
 }
 
 /** Store the value in rI to memory. */
 void Computer::executeSTi(const InstructionWord& instruction) {
     const int address = getIndexedAddress(instruction, true);
+    if (faulted()) {
+        return;
+    }
     const int registerIndex = instruction.operation() - Instructions::ST1 + 1;
-    const auto& rIi = rI(registerIndex);
+    const auto& rIi = indexRegister(registerIndex);
     const ComputerWord word(rIi.negative, 0, 0, 0, rIi[1], rIi[2]);
     copyFromRegister5(instruction, word, &memory[address]);
 }
@@ -26,6 +32,9 @@ void Computer::executeSTi(const InstructionWord& instruction) {
 /** Store the value in rJ to memory. */
 void Computer::executeSTJ(const InstructionWord& instruction) {
     const int address = getIndexedAddress(instruction, true);
+    if (faulted()) {
+        return;
+    }
     const ComputerWord word('+', 0, 0, 0, rJ[1], rJ[2]);
     copyFromRegister5(instruction, word, &memory[address]);
 }
@@ -33,6 +42,9 @@ void Computer::executeSTJ(const InstructionWord& instruction) {
 /** Store zeros to memory. */
 void Computer::executeSTZ(const InstructionWord& instruction) {
     const int address = getIndexedAddress(instruction, true);
+    if (faulted()) {
+        return;
+    }
     const ComputerWord word('+', 0, 0, 0, 0, 0);
     copyFromRegister5(instruction, word, &memory[address]);
 }
@@ -0,0 +1,34 @@
+#include "machine.h"
+
+/**
+ * @file
+ * @brief Timeline of device activities.
+ */
+
+namespace mixal {
+
+void Computer::setDeviceTraceCapacity(const size_t capacity) {
+    _trace = DeviceTrace(capacity);
+    _tracedBusy.reset();
+}
+
+void Computer::clearDeviceTrace() {
+    _trace.clear();
+    _tracedBusy.reset();
+}
+
+/** The operation is completed at once if the device is not busy after accepting it. */
+void Computer::traceStart(const int32_t unit, const Instructions::Code operation) {
+    _trace.record({_elapsed, 0, unit, DeviceEventType::START, static_cast<uint8_t>(operation)});
+    _tracedBusy.set(unit);
+    traceCompletion(unit);
+}
+
+void Computer::traceCompletion(const int32_t unit) {
+    if (_tracedBusy.test(unit) && !devices[unit]->busy()) {
+        _trace.record({_elapsed, 0, unit, DeviceEventType::COMPLETE, 0});
+        _tracedBusy.reset(unit);
+    }
+}
+
+}  // namespace mixal
@@ -1,6 +1,9 @@
+#include <array>
 #include <stdexcept>
 #include <string>
 #include <iostream>
+#include <utility>
+#include <vector>
 #include "memory.h"
 #include "unicode_utils.h"
 
@@ -32,7 +35,7 @@ std::ostream& operator<<(std::ostream& out, const ComputerWord& word) {
 ComputerWord::ComputerWord() : negative(), byte1(), byte2(), byte3(), byte4(), byte5() {
 }
 
-ComputerWord::ComputerWord(const int32_t value) : negative(), byte1(), byte2(), byte3(), byte4(), byte5() {
+ComputerWord::ComputerWord(const WordValue value) : negative(), byte1(), byte2(), byte3(), byte4(), byte5() {
     set(value);
 }
 
@@ -53,11 +56,13 @@ ComputerWord::ComputerWord(const char sign, const uint8_t _byte1, const uint8_t
 }
 
 ComputerWord::ComputerWord(const bool _negative, const uint16_t bytes12, const uint8_t _byte3, const uint8_t _byte4, const uint8_t _byte5) :
-    negative(_negative), byte1(bytes12 / 64), byte2(bytes12 % 64), byte3(_byte3), byte4(_byte4), byte5(_byte5) {
+    negative(_negative), byte1(WordFormat::byteAt(bytes12, 1)), byte2(WordFormat::byteAt(bytes12, 0)),
+    byte3(_byte3), byte4(_byte4), byte5(_byte5) {
 }
 
 ComputerWord::ComputerWord(const char sign, const uint16_t bytes12, const uint8_t _byte3, const uint8_t _byte4, const uint8_t _byte5) :
-    negative(sign == '-'), byte1(bytes12 / 64), byte2(bytes12 % 64), byte3(_byte3), byte4(_byte4), byte5(_byte5) {
+    negative(sign == '-'), byte1(WordFormat::byteAt(bytes12, 1)), byte2(WordFormat::byteAt(bytes12, 0)),
+    byte3(_byte3), byte4(_byte4), byte5(_byte5) {
     if (sign != '+' && sign != '-') {
         throw std::runtime_error("Invalid sign: " + std::string(1, sign));
     }
@@ -108,9 +113,7 @@ uint8_t& ComputerWord::operator[](const int index) {
 }
 
 uint16_t ComputerWord::bytes2(const int index1, const int index2) const {
-    const int16_t high = (*this)[index1];
-    const int16_t low = (*this)[index2];
-    return high * 64 + low;
+    return WordFormat::combine<uint16_t>((*this)[index1], (*this)[index2]);
 }
 
 uint16_t ComputerWord::bytes12() const {
@@ -129,24 +132,29 @@ uint16_t ComputerWord::bytes45() const {
     return bytes2(4, 5);
 }
 
-int32_t ComputerWord::value() const {
-    const int32_t value = (byte1 << 24) | (byte2 << 18) | (byte3 << 12) | (byte4 << 6) | static_cast<int32_t>(byte5);
+WordValue ComputerWord::value() const {
+    using F = WordFormat;
+    const auto value = F::combine<WordValue>(F::combine<WordValue>(F::combine<WordValue>(
+                           F::combine<WordValue>(byte1, byte2), byte3), byte4), byte5);
     return negative ? -value : value;
 }
 
 double ComputerWord::floatValue() const {
     const int32_t exp = byte1;
-    const uint32_t fraction = (static_cast<uint32_t>(byte2) << 18) |
-                              (static_cast<uint32_t>(byte3) << 12) |
-                              (static_cast<uint32_t>(byte4) << 6) |
-                              static_cast<uint32_t>(byte5);
+    const auto fraction = floatFraction();
     if (fraction == 0) {
         return 0.0;
     }
-    const double value = static_cast<double>(fraction) * std::pow(64.0, exp - ComputerWord::MIX_FLOAT_BIAS - 4);
+    const double value = static_cast<double>(fraction) *
+                         std::pow(static_cast<double>(BYTE_SIZE), exp - ComputerWord::MIX_FLOAT_BIAS - 4);
     return negative ? -value : value;
 }
 
+int64_t ComputerWord::floatFraction() const {
+    using F = WordFormat;
+    return F::combine<int64_t>(F::combine<int64_t>(F::combine<int64_t>(byte2, byte3), byte4), byte5);
+}
+
 int16_t ComputerWord::addressValue() const {
     auto value = static_cast<int16_t>(this->bytes12());
     if (negative) {
@@ -161,40 +169,45 @@ void ComputerWord::setAddress(int16_t address) {
         negative = true;
         address = -address;
     }
-    byte1 = static_cast<uint8_t>(address / 64);
-    byte2 = static_cast<uint8_t>(address % 64);
+    byte1 = WordFormat::byteAt(address, 1);
+    byte2 = WordFormat::byteAt(address, 0);
 }
 
 void ComputerWord::setAddress(const bool _negative, const uint16_t address) {
     this->negative = _negative;
-    byte1 = static_cast<uint8_t>(address / 64);
-    byte2 = static_cast<uint8_t>(address % 64);
+    byte1 = WordFormat::byteAt(address, 1);
+    byte2 = WordFormat::byteAt(address, 0);
 }
 
 std::string ComputerWord::getCharacters() const {
-    std::string chars;
-    for (int i = 1; i <= 5; ++i) {
-        if (getAt(i) < CHAR_CODES_NUM) {
-            const uint16_t code = CHAR_CODES[getAt(i)];
-            chars += unicode_utils::codepointsToUtf8({static_cast<int32_t>(code)});
-        } else {
-            chars += ' ';
-        }
-    }
-    return chars;
+    return wordsToText(this, 1);
 }
 
-void ComputerWord::set(int32_t value) {
+namespace {
+
+template<typename T>
+void setInteger(ComputerWord* word, T value) {
     if (value > 0) {
-        negative = false;
+        word->negative = false;
     } else if (value < 0) {
-        negative = true;
+        word->negative = true;
         value = -value;
     }
-    for (int i = 5; i >= 1; --i) {
-        set(i, static_cast<uint8_t>(value & ((1 << 6) - 1)));
-        value >>= 6;
-    }
+    word->byte5 = WordFormat::byteAt(value, 0);
+    word->byte4 = WordFormat::byteAt(value, 1);
+    word->byte3 = WordFormat::byteAt(value, 2);
+    word->byte2 = WordFormat::byteAt(value, 3);
+    word->byte1 = WordFormat::byteAt(value, 4);
+}
+
+}  // namespace
+
+void ComputerWord::set(const int64_t value) {
+    setInteger(this, value);
+}
+
+void ComputerWord::set(const int32_t value) {
+    setInteger(this, value);
 }
 
 bool ComputerWord::set(double value) {
@@ -208,19 +221,19 @@ bool ComputerWord::set(double value) {
         value = -value;
     }
     int32_t exp = MIX_FLOAT_BIAS;
-    constexpr double MIN_FRAC = 64.0 * 64.0 * 64.0;
-    constexpr double MAX_FRAC = 64.0 * 64.0 * 64.0 * 64.0;
+    constexpr auto MIN_FRAC = static_cast<double>(WordFormat::power(3));
+    constexpr auto MAX_FRAC = static_cast<double>(WordFormat::power(4));
     double fraction = value * MAX_FRAC;
-    while (fraction >= MAX_FRAC && exp < 63) {
-        fraction /= 64;
+    while (fraction >= MAX_FRAC && exp < BYTE_SIZE - 1) {
+        fraction /= BYTE_SIZE;
         ++exp;
     }
     while (fraction < MIN_FRAC && exp > 0) {
-        fraction *= 64;
+        fraction *= BYTE_SIZE;
         --exp;
     }
     if (fraction >= MAX_FRAC) {
-        exp = 63;
+        exp = BYTE_SIZE - 1;
         fraction = MAX_FRAC - 1;
         overflow = true;
     }
@@ -228,30 +241,65 @@ bool ComputerWord::set(double value) {
         fraction = 0.0;
         overflow = true;
     }
-    const auto frac = static_cast<uint32_t>(std::round(fraction));
+    const auto frac = static_cast<int64_t>(std::round(fraction));
     byte1 = static_cast<uint8_t>(exp);
-    byte2 = static_cast<uint8_t>((frac >> 18) & 0b00111111);
-    byte3 = static_cast<uint8_t>((frac >> 12) & 0b00111111);
-    byte4 = static_cast<uint8_t>((frac >> 6) & 0b00111111);
-    byte5 = static_cast<uint8_t>(frac & 0b00111111);
+    byte2 = WordFormat::byteAt(frac, 3);
+    byte3 = WordFormat::byteAt(frac, 2);
+    byte4 = WordFormat::byteAt(frac, 1);
+    byte5 = WordFormat::byteAt(frac, 0);
     return overflow;
 }
 
-void ComputerWord::set(const std::string& chars) {
-    const auto codes = unicode_utils::utf8ToCodepoints(chars);
-    if (codes.size() != 5) {
-        throw std::runtime_error("Invalid length of characters for a word: " + chars);
+bool ComputerWord::setFloat(const bool _negative, int32_t exponent, int64_t fraction, int digits, bool inexact) {
+    using F = WordFormat;
+    reset();
+    if (fraction == 0) {
+        return false;
     }
-    negative = false;
-    for (int i = 0; i < 5; ++i) {
-        (*this)[i + 1] = 0;
-        for (int j = 0; j < CHAR_CODES_NUM; ++j) {
-            if (static_cast<uint16_t>(codes[i]) == CHAR_CODES[j]) {
-                (*this)[i + 1] = j;
-                break;
-            }
+    while (fraction >= F::power(digits)) {
+        if (digits < F::MAX_BYTES) {
+            ++digits;
+        } else {
+            inexact = inexact || F::lowBytes(fraction, 1) != 0;
+            fraction = F::shiftRight(fraction, 1);
+        }
+        ++exponent;
+    }
+    while (fraction < F::power(digits - 1)) {
+        if (digits > MIX_FLOAT_DIGITS) {
+            --digits;
+        } else {
+            fraction *= BYTE_SIZE;
         }
+        --exponent;
     }
+    const int extra = digits - MIX_FLOAT_DIGITS;
+    const int64_t half = F::lowBytes(fraction, extra) * 2;
+    auto rounded = F::shiftRight(fraction, extra);
+    if (half > F::power(extra) ||
+        (half == F::power(extra) && (inexact || (rounded + BYTE_SIZE / 2) % 2 == 0))) {
+        ++rounded;
+    }
+    if (rounded == F::power(MIX_FLOAT_DIGITS)) {
+        rounded = F::power(MIX_FLOAT_DIGITS - 1);
+        ++exponent;
+    }
+    const bool overflow = exponent < 0 || BYTE_SIZE <= exponent;
+    negative = _negative;
+    byte1 = static_cast<uint8_t>((exponent % BYTE_SIZE + BYTE_SIZE) % BYTE_SIZE);
+    byte2 = F::byteAt(rounded, 3);
+    byte3 = F::byteAt(rounded, 2);
+    byte4 = F::byteAt(rounded, 1);
+    byte5 = F::byteAt(rounded, 0);
+    return overflow;
+}
+
+void ComputerWord::set(const std::string& chars) {
+    ComputerWord word;
+    if (textToWords(chars, &word, 1) != 5) {
+        throw std::runtime_error("Invalid length of characters for a word: " + chars);
+    }
+    *this = word;
 }
 
 void ComputerWord::set(const int index, const uint8_t val) {
@@ -290,8 +338,8 @@ void ComputerWord::set(const char sign, const uint8_t _byte1, const uint8_t _byt
 
 void ComputerWord::set(const bool _negative, const uint16_t bytes12, const uint8_t _byte3, const uint8_t _byte4, const uint8_t _byte5) {
     this->negative = _negative;
-    this->byte1 = static_cast<uint8_t>(bytes12 / 64);
-    this->byte2 = static_cast<uint8_t>(bytes12 % 64);
+    this->byte1 = WordFormat::byteAt(bytes12, 1);
+    this->byte2 = WordFormat::byteAt(bytes12, 0);
     this->byte3 = _byte3;
     this->byte4 = _byte4;
     this->byte5 = _byte5;
@@ -302,11 +350,134 @@ void ComputerWord::set(const char sign, const uint16_t bytes12, const uint8_t _b
         throw std::runtime_error("Invalid sign: " + std::string(1, sign));
     }
     this->negative = sign == '-';
-    this->byte1 = static_cast<uint8_t>(bytes12 / 64);
-    this->byte2 = static_cast<uint8_t>(bytes12 % 64);
+    this->byte1 = WordFormat::byteAt(bytes12, 1);
+    this->byte2 = WordFormat::byteAt(bytes12, 0);
     this->byte3 = _byte3;
     this->byte4 = _byte4;
     this->byte5 = _byte5;
 }
 
+namespace {
+
+/** Marks the ASCII bytes that are not in the mapping. */
+constexpr uint8_t UNKNOWN_CHARACTER = 0xff;
+/** Marks the bytes that start or continue a multi-byte UTF-8 sequence. */
+constexpr uint8_t MULTI_BYTE = 0xfe;
+
+/** Conversion tables built from `CHAR_CODES` at the first conversion. */
+struct CharacterTables {
+    std::array<uint8_t, 256> fromAscii{};  /**< MIX byte of each ASCII byte. */
+    std::vector<std::pair<int32_t, uint8_t>> fromWide;  /**< MIX byte of each non-ASCII code point. */
+    std::array<std::string, BYTE_SIZE> toUtf8;    /**< UTF-8 encoding of each MIX byte. */
+
+    CharacterTables() {
+        fromAscii.fill(UNKNOWN_CHARACTER);
+        for (int i = 0x80; i < 0x100; ++i) {
+            fromAscii[i] = MULTI_BYTE;
+        }
+        toUtf8.fill(" ");
+        for (int i = 0; i < CHAR_CODES_NUM; ++i) {
+            const auto code = static_cast<int32_t>(CHAR_CODES[i]);
+            if (code < 0x80) {
+                fromAscii[code] = static_cast<uint8_t>(i);
+            } else {
+                fromWide.emplace_back(code, static_cast<uint8_t>(i));
+            }
+            toUtf8[i] = unicode_utils::codepointsToUtf8({static_cast<char32_t>(code)});
+        }
+    }
+};
+
+const CharacterTables& characterTables() {
+    static const CharacterTables tables;
+    return tables;
+}
+
+/** Decode the MIX byte of one character starting at the offset, and move the offset to the next character. */
+uint8_t decodeCharacter(const CharacterTables& tables, const std::string_view text, size_t* offset) {
+    const auto lead = static_cast<uint8_t>(text[*offset]);
+    const uint8_t byte = tables.fromAscii[lead];
+    if (byte != MULTI_BYTE) {
+        ++*offset;
+        return byte == UNKNOWN_CHARACTER ? 0 : byte;
+    }
+    int length = 1;
+    int32_t code = 0;
+    if ((lead & 0xe0) == 0xc0) {
+        length = 2;
+        code = lead & 0x1f;
+    } else if ((lead & 0xf0) == 0xe0) {
+        length = 3;
+        code = lead & 0x0f;
+    } else if ((lead & 0xf8) == 0xf0) {
+        length = 4;
+        code = lead & 0x07;
+    }
+    if (length == 1 || *offset + length > text.size()) {
+        ++*offset;
+        return 0;
+    }
+    for (int i = 1; i < length; ++i) {
+        const auto next = static_cast<uint8_t>(text[*offset + i]);
+        if ((next & 0xc0) != 0x80) {
+            ++*offset;
+            return 0;
+        }
+        code = (code << 6) | (next & 0x3f);
+    }
+    *offset += length;
+    for (const auto& [wide, mixByte] : tables.fromWide) {
+        if (wide == code) {
+            return mixByte;
+        }
+    }
+    return 0;
+}
+
+}  // namespace
+
+size_t textToWords(const std::string_view text, ComputerWord* words, const int32_t count) {
+    const auto& tables = characterTables();
+    const size_t capacity = count > 0 ? static_cast<size_t>(count) * 5 : 0;
+    size_t numCharacters = 0;
+    size_t offset = 0;
+    while (offset < text.size()) {
+        const uint8_t byte = decodeCharacter(tables, text, &offset);
+        if (numCharacters < capacity) {
+            auto& word = words[numCharacters / 5];
+            switch (numCharacters % 5) {
+            case 0: word.negative = false; word.byte1 = byte; break;
+            case 1: word.byte2 = byte; break;
+            case 2: word.byte3 = byte; break;
+            case 3: word.byte4 = byte; break;
+            default: word.byte5 = byte; break;
+            }
+        }
+        ++numCharacters;
+    }
+    for (size_t i = numCharacters; i < capacity; ++i) {
+        auto& word = words[i / 5];
+        switch (i % 5) {
+        case 0: word.negative = false; word.byte1 = 0; break;
+        case 1: word.byte2 = 0; break;
+        case 2: word.byte3 = 0; break;
+        case 3: word.byte4 = 0; break;
+        default: word.byte5 = 0; break;
+        }
+    }
+    return numCharacters;
+}
+
+std::string wordsToText(const ComputerWord* words, const int32_t count) {
+    const auto& tables = characterTables();
+    std::string text;
+    text.reserve(count > 0 ? static_cast<size_t>(count) * 5 : 0);
+    for (int32_t i = 0; i < count; ++i) {
+        for (const uint8_t byte : {words[i].byte1, words[i].byte2, words[i].byte3, words[i].byte4, words[i].byte5}) {
+            text += byte < BYTE_SIZE ? tables.toUtf8[byte] : " ";
+        }
+    }
+    return text;
+}
+
 }  // namespace mixal
@@ -60,8 +60,9 @@ bool ParsedResult::evaluateAddress(const std::unordered_map<std::string, AtomicV
     if (!address.evaluated() && !address.evaluate(constants)) {
         return false;
     }
-    const int32_t value = address.result().value;
-    if (parsedType == ParsedType::INSTRUCTION && !address.literalConstant() && std::abs(value) >= 4096) {
+    const WordValue value = address.result().value;
+    if (parsedType == ParsedType::INSTRUCTION && !address.literalConstant() &&
+        std::abs(value) >= WordFormat::power(2)) {
         throw ParseError(_index, "Address can not be represented in 2 bytes: " + std::to_string(value));
     }
     word.setAddress(address.result().negative, static_cast<uint16_t>(std::abs(value)));
@@ -72,7 +73,7 @@ bool ParsedResult::evaluateIndex(const std::unordered_map<std::string, AtomicVal
     if (!index.evaluated() && !index.evaluate(constants)) {
         return false;
     }
-    const int32_t value = index.result().value;
+    const WordValue value = index.result().value;
     if (value < 0 || 6 < value) {
         throw ParseError(_index, "Invalid index value: " + std::to_string(value));
     }
@@ -84,13 +85,12 @@ bool ParsedResult::evaluateField(const std::unordered_map<std::string, AtomicVal
     if (!field.evaluated() && !field.evaluate(constants)) {
         return false;
     }
-    const int32_t value = field.result().value;
-    const int32_t defaultField = Instructions::getDefaultField(operation);
+    const WordValue value = field.result().value;
     if (defaultField >= 0 && value != defaultField) {
         throw ParseError(_index, "The given field value does not match the default one: " +
                                 std::to_string(value) + " != " + std::to_string(defaultField));
     }
-    if (value < 0 || 64 <= value) {
+    if (value < 0 || BYTE_SIZE <= value) {
         throw ParseError(_index, "Invalid field value: " + std::to_string(value));
     }
     word.setField(static_cast<uint8_t>(value));
@@ -212,7 +212,8 @@ ParsedResult Parser::parseLine(const std::string& line, const std::string& lineS
             if (ch == ' ' || ch == END_CHAR) {
                 result.operation = line.substr(operationStart, i - operationStart);
                 result.operationSpan = TokenSpan(operationStart, i);
-                auto operation = static_cast<int>(Instructions::getInstructionCode(result.operation));
+                const auto info = Instructions::findOperation(result.operation);
+                const int operation = info == nullptr ? Instructions::INVALID : info->code;
                 if (ch == ' ') {
                     if (Instructions::hasArguments(static_cast<Instructions::Code>(operation))) {
                         state = ParseState::BEFORE_ADDRESS;
@@ -227,7 +228,8 @@ ParsedResult Parser::parseLine(const std::string& line, const std::string& lineS
                 }
                 if (operation <= Instructions::LAST) {
                     result.word.setOperation(static_cast<uint8_t>(operation));
-                    defaultField = Instructions::getDefaultField(result.operation);
+                    defaultField = info->defaultField;
+                    result.defaultField = info->defaultField;
                 } else {
                     result.parsedType = ParsedType::PSEUDO;
                     result.word.setOperation(static_cast<uint8_t>(operation - Instructions::PSEUDO));
@@ -249,7 +251,7 @@ ParsedResult Parser::parseLine(const std::string& line, const std::string& lineS
                             }
                             i += bytesConsumed - 1;
                         }
-                        const int32_t charsValue = ComputerWord(result.rawAddress).value();
+                        const WordValue charsValue = ComputerWord(result.rawAddress).value();
                         result.address = Expression::getConstExpression(AtomicValue(charsValue));
                         if (i < static_cast<int>(line.size())) {
                             state = ParseState::BEFORE_COMMENT;
@@ -33,9 +33,7 @@ uint8_t Register2::operator[](const int index) const {
 }
 
 uint16_t Register2::bytes12() const {
-    const int16_t high = static_cast<uint8_t>(byte1);
-    const int16_t low = static_cast<uint8_t>(byte2);
-    return high * 64 + low;
+    return WordFormat::combine<uint16_t>(byte1, byte2);
 }
 
 int16_t Register2::value() const {
@@ -63,8 +61,8 @@ void Register2::set(int16_t value) {
         negative = true;
         value = -value;
     }
-    byte1 = static_cast<uint8_t>(value / (1 << 6));
-    byte2 = static_cast<uint8_t>(value % (1 << 6));
+    byte1 = WordFormat::byteAt(value, 1);
+    byte2 = WordFormat::byteAt(value, 0);
 }
 
 void Register2::set(const int index, const int8_t val) {
@@ -0,0 +1,570 @@
+#include <algorithm>
+#include <stdexcept>
+#include "timing.h"
+
+/**
+ * @file
+ * @brief Static timing analysis of MIX programs.
+ */
+
+namespace mixal {
+
+namespace {
+
+constexpr int32_t NUM_MEMORY = Computer::NUM_MEMORY;
+
+/** The coefficients of an expression indexed by the sorted symbols of the terms. */
+using Polynomial = std::map<std::vector<std::string>, int64_t>;
+
+/** Add the terms multiplied by a coefficient and the product of the symbols. */
+void addTerms(Polynomial* sum, const Polynomial& terms, const int64_t coefficient,
+              const std::vector<std::string>& symbols) {
+    for (const auto& [termSymbols, termCoefficient] : terms) {
+        auto product = termSymbols;
+        product.insert(product.end(), symbols.begin(), symbols.end());
+        std::sort(product.begin(), product.end());
+        (*sum)[product] += termCoefficient * coefficient;
+    }
+}
+
+CostExpression toExpression(const Polynomial& polynomial) {
+    CostExpression expression;
+    for (const auto& [symbols, coefficient] : polynomial) {
+        if (coefficient != 0) {
+            expression.terms.push_back({coefficient, symbols});
+        }
+    }
+    std::stable_sort(expression.terms.begin(), expression.terms.end(), [](const CostTerm& a, const CostTerm& b) {
+        return a.symbols.size() < b.symbols.size();
+    });
+    return expression;
+}
+
+bool isJump(const int operation) {
+    return operation == Instructions::JBUS || operation == Instructions::JRED ||
+           (Instructions::JMP <= operation && operation <= Instructions::JXN);
+}
+
+bool isHalt(const InstructionWord& word) {
+    return word.operation() == Instructions::HLT && word.field() == 2;
+}
+
+/** The integer division rounded up of positive values. */
+int64_t ceilDivide(const int64_t a, const int64_t b) {
+    return (a + b - 1) / b;
+}
+
+/** The executions of a loop body that ends with `Ji` of the field, starting from the value and adding the step.
+ *
+ * @return -1 if the loop may not terminate.
+ */
+int64_t countIterations(int field, int64_t value, int64_t step) {
+    if (field == 0 || field == 5) {
+        value = -value;
+        step = -step;
+        field = field == 0 ? 2 : 3;
+    }
+    if (field == 4) {
+        return step != 0 && value % step == 0 && -value / step >= 1 ? -value / step : -1;
+    }
+    if ((field != 2 && field != 3) || step >= 0) {
+        return -1;
+    }
+    if (field == 2) {
+        return value > 0 ? ceilDivide(value, -step) : 1;
+    }
+    return value >= 0 ? value / -step + 1 : 1;
+}
+
+/** The control flow between the instructions of a loaded program. */
+struct ControlFlow {
+    const Computer& machine;
+    std::vector<bool> modified;   /**< The locations written by stores with constant addresses. */
+    std::vector<bool> reachable;  /**< The locations that may be executed. */
+    std::vector<int32_t> roots;   /**< The entry, the interrupt handler and the subroutines. */
+
+    explicit ControlFlow(const Computer& _machine) : machine(_machine), modified(NUM_MEMORY), reachable(NUM_MEMORY) {}
+
+    /** The subroutine called by the instruction at the location, -1 if it is not a call. */
+    [[nodiscard]] int32_t callee(const int32_t location) const {
+        const auto& word = machine.memory[location];
+        const int32_t target = word.addressValue();
+        if (word.operation() != Instructions::JMP || word.field() != 0 || word.index() != 0 || modified[location] ||
+            target < 0 || NUM_MEMORY <= target || machine.memory[target].operation() != Instructions::STJ) {
+            return -1;
+        }
+        return target;
+    }
+
+    /** The locations that may follow the instruction at the location, excluding the called subroutine. */
+    [[nodiscard]] std::vector<int32_t> successors(const int32_t location) const {
+        const auto& word = machine.memory[location];
+        const int operation = word.operation();
+        std::vector<int32_t> result;
+        if (isHalt(word)) {
+            return result;
+        }
+        if (isJump(operation) && callee(location) < 0) {
+            const int32_t target = word.addressValue();
+            if (word.index() == 0 && !modified[location] && 0 <= target && target < NUM_MEMORY) {
+                result.push_back(target);
+            }
+            if (operation == Instructions::JMP && word.field() <= 1) {
+                return result;
+            }
+        }
+        if (location + 1 < NUM_MEMORY && (result.empty() || result.front() != location + 1)) {
+            result.push_back(location + 1);
+        }
+        return result;
+    }
+
+    /** Find the reachable locations and the called subroutines from the roots. */
+    void findReachable(const std::vector<int32_t>& initialRoots) {
+        roots.clear();
+        std::fill(reachable.begin(), reachable.end(), false);
+        std::vector<int32_t> stack;
+        auto push = [&](const int32_t location) {
+            if (0 <= location && location < NUM_MEMORY && !reachable[location]) {
+                reachable[location] = true;
+                stack.push_back(location);
+            }
+        };
+        for (const auto root : initialRoots) {
+            if (0 <= root && root < NUM_MEMORY && std::find(roots.begin(), roots.end(), root) == roots.end()) {
+                roots.push_back(root);
+            }
+            push(root);
+        }
+        while (!stack.empty()) {
+            const int32_t location = stack.back();
+            stack.pop_back();
+            for (const auto next : successors(location)) {
+                push(next);
+            }
+            if (const int32_t target = callee(location); target >= 0) {
+                if (std::find(roots.begin(), roots.end(), target) == roots.end()) {
+                    roots.push_back(target);
+                }
+                push(target);
+            }
+        }
+    }
+
+    /** Mark the locations written by the reachable stores with constant addresses. */
+    void findModified() {
+        for (int32_t location = 0; location < NUM_MEMORY; ++location) {
+            const auto& word = machine.memory[location];
+            const int32_t address = word.addressValue();
+            if (reachable[location] && Instructions::STA <= word.operation() && word.operation() <= Instructions::STZ &&
+                word.index() == 0 && 0 <= address && address < NUM_MEMORY) {
+                modified[address] = true;
+            }
+        }
+    }
+};
+
+/** The blocks of the control flow with the edges between their indices. */
+struct BlockGraph {
+    std::vector<TimingBlock> blocks;
+    std::vector<int32_t> blockAt;  /**< The index of the block that contains each location, -1 if unreachable. */
+    std::vector<std::vector<int32_t>> successors;
+    std::vector<std::vector<int32_t>> predecessors;
+
+    explicit BlockGraph(const ControlFlow& flow) : blockAt(NUM_MEMORY, -1) {
+        const auto& memory = flow.machine.memory;
+        std::vector<bool> leader(NUM_MEMORY);
+        for (const auto root : flow.roots) {
+            leader[root] = true;
+        }
+        for (int32_t location = 0; location < NUM_MEMORY; ++location) {
+            if (!flow.reachable[location]) {
+                continue;
+            }
+            for (const auto next : flow.successors(location)) {
+                if (next != location + 1) {
+                    leader[next] = true;
+                }
+            }
+            if ((isJump(memory[location].operation()) || isHalt(memory[location])) && location + 1 < NUM_MEMORY) {
+                leader[location + 1] = true;
+            }
+        }
+        for (int32_t location = 0; location < NUM_MEMORY; ++location) {
+            if (!flow.reachable[location]) {
+                continue;
+            }
+            if (location == 0 || blockAt[location - 1] < 0 || leader[location]) {
+                blocks.emplace_back();
+                blocks.back().start = location;
+            }
+            auto& block = blocks.back();
+            const auto& word = memory[location];
+            ++block.length;
+            if (!isHalt(word)) {
+                block.cost += Instructions::getCost(static_cast<Instructions::Code>(word.operation()), word.field());
+            }
+            blockAt[location] = static_cast<int32_t>(blocks.size()) - 1;
+        }
+        successors.resize(blocks.size());
+        predecessors.resize(blocks.size());
+        for (size_t index = 0; index < blocks.size(); ++index) {
+            auto& block = blocks[index];
+            for (const auto next : flow.successors(block.start + block.length - 1)) {
+                block.successors.push_back(next);
+                successors[index].push_back(blockAt[next]);
+                predecessors[blockAt[next]].push_back(static_cast<int32_t>(index));
+            }
+        }
+    }
+
+    [[nodiscard]] int32_t last(const int32_t index) const { return blocks[index].start + blocks[index].length - 1; }
+};
+
+/** A loop with the blocks of its body. */
+struct LoopBody {
+    TimingLoop loop;
+    std::vector<bool> contains;  /**< Whether each block is in the loop. */
+    std::vector<int32_t> latches;
+    int32_t size = 0;
+};
+
+/** Infer the iterations of a loop closed by an index register jump, see `TimingLoop::iterations`. */
+void inferIterations(const ControlFlow& flow, const BlockGraph& graph, const int32_t headerIndex, LoopBody* body) {
+    const auto& memory = flow.machine.memory;
+    auto& loop = body->loop;
+    const int32_t latch = body->latches.size() == 1 ? graph.last(body->latches.front()) : -1;
+    if (latch < 0) {
+        return;
+    }
+    const auto& jump = memory[latch];
+    if (jump.operation() < Instructions::J1N || Instructions::J6N < jump.operation() || jump.index() != 0 ||
+        jump.addressValue() != loop.header) {
+        return;
+    }
+    const int registerIndex = jump.operation() - Instructions::J1N + 1;
+    loop.counter = registerIndex;
+    const int inc = Instructions::INC1 + registerIndex - 1;
+    /** Whether the instruction may change the counter other than with a constant `INCi` or `DECi`. */
+    auto changes = [&](const int32_t location) {
+        const auto& word = memory[location];
+        const int operation = word.operation();
+        return flow.callee(location) >= 0 || operation == Instructions::LD1 + registerIndex - 1 ||
+               operation == Instructions::LD1N + registerIndex - 1 ||
+               (operation == Instructions::MOVE && registerIndex == 1) ||
+               (operation == inc && (word.field() > 1 || word.index() != 0));
+    };
+    int64_t step = 0;
+    for (size_t index = 0; index < graph.blocks.size(); ++index) {
+        if (!body->contains[index]) {
+            continue;
+        }
+        for (int32_t location = graph.blocks[index].start; location <= graph.last(static_cast<int32_t>(index)); ++location) {
+            const auto& word = memory[location];
+            if (changes(location) || (word.operation() == inc && index != static_cast<size_t>(graph.blockAt[latch]))) {
+                return;
+            }
+            if (word.operation() == inc) {
+                step += word.field() == 0 ? word.addressValue() : -word.addressValue();
+            }
+        }
+    }
+    int32_t entering = -1;
+    for (const auto predecessor : graph.predecessors[headerIndex]) {
+        if (!body->contains[predecessor]) {
+            if (entering >= 0) {
+                return;
+            }
+            entering = predecessor;
+        }
+    }
+    if (entering < 0) {
+        return;
+    }
+    for (int32_t location = graph.last(entering); location >= graph.blocks[entering].start; --location) {
+        const auto& word = memory[location];
+        if (word.operation() == inc && (word.field() == 2 || word.field() == 3) && word.index() == 0) {
+            const int64_t value = word.field() == 2 ? word.addressValue() : -word.addressValue();
+            loop.iterations = countIterations(jump.field(), value, step);
+            return;
+        }
+        if (changes(location) || word.operation() == inc) {
+            return;
+        }
+    }
+}
+
+}  // namespace
+
+int64_t CostExpression::evaluate(const std::map<std::string, int64_t>& values) const {
+    int64_t sum = 0;
+    for (const auto& term : terms) {
+        int64_t product = term.coefficient;
+        for (const auto& symbol : term.symbols) {
+            const auto it = values.find(symbol);
+            if (it == values.end()) {
+                throw std::runtime_error("No value for the symbol: " + symbol);
+            }
+            product *= it->second;
+        }
+        sum += product;
+    }
+    return sum;
+}
+
+std::string CostExpression::toString() const {
+    if (terms.empty()) {
+        return "0";
+    }
+    std::string result;
+    for (const auto& term : terms) {
+        if (!result.empty()) {
+            result += " + ";
+        }
+        std::string product = term.coefficient != 1 || term.symbols.empty() ? std::to_string(term.coefficient) : "";
+        for (const auto& symbol : term.symbols) {
+            product += (product.empty() ? "" : "*") + symbol;
+        }
+        result += product;
+    }
+    return result;
+}
+
+TimingAnalysis analyzeTiming(const Computer& machine, const int32_t entry) {
+    std::vector<int32_t> initialRoots = {entry};
+    const int32_t handler = machine.interruptVector() >= 0 ? machine.interruptVector() + Computer::INTERRUPT_SAVE_SIZE : -1;
+    if (handler >= 0) {
+        initialRoots.push_back(handler);
+    }
+    ControlFlow flow(machine);
+    flow.findReachable(initialRoots);
+    flow.findModified();
+    flow.findReachable(initialRoots);
+    if (flow.roots.empty() || flow.roots.front() != entry) {
+        return {};
+    }
+    BlockGraph graph(flow);
+    const auto numBlocks = static_cast<int32_t>(graph.blocks.size());
+
+    // Depth-first search from each root, the edges to the blocks on the stack close the loops.
+    std::vector<int32_t> region(numBlocks, -1);
+    std::vector<int> state(numBlocks, 0);
+    std::vector<std::vector<int32_t>> latches(numBlocks);
+    for (size_t root = 0; root < flow.roots.size(); ++root) {
+        const int32_t start = graph.blockAt[flow.roots[root]];
+        if (state[start] != 0) {
+            continue;
+        }
+        std::vector<std::pair<int32_t, size_t>> stack = {{start, 0}};
+        state[start] = 1;
+        region[start] = static_cast<int32_t>(root);
+        while (!stack.empty()) {
+            auto& [index, next] = stack.back();
+            if (next == graph.successors[index].size()) {
+                state[index] = 2;
+                stack.pop_back();
+                continue;
+            }
+            const int32_t successor = graph.successors[index][next++];
+            if (state[successor] == 1) {
+                latches[successor].push_back(index);
+            } else if (state[successor] == 0) {
+                state[successor] = 1;
+                region[successor] = static_cast<int32_t>(root);
+                stack.emplace_back(successor, 0);
+            }
+        }
+    }
+
+    std::vector<LoopBody> bodies;
+    for (int32_t header = 0; header < numBlocks; ++header) {
+        if (latches[header].empty()) {
+            continue;
+        }
+        LoopBody body;
+        body.contains.resize(numBlocks);
+        body.latches = latches[header];
+        body.contains[header] = true;
+        std::vector<int32_t> stack = latches[header];
+        while (!stack.empty()) {
+            const int32_t index = stack.back();
+            stack.pop_back();
+            if (!body.contains[index]) {
+                body.contains[index] = true;
+                stack.insert(stack.end(), graph.predecessors[index].begin(), graph.predecessors[index].end());
+            }
+        }
+        auto& loop = body.loop;
+        loop.header = graph.blocks[header].start;
+        for (const auto latch : body.latches) {
+            loop.latch = std::max(loop.latch, graph.last(latch));
+        }
+        loop.symbol = "L" + std::to_string(loop.header);
+        for (int32_t index = 0; index < numBlocks; ++index) {
+            if (body.contains[index]) {
+                loop.blocks.push_back(graph.blocks[index].start);
+                ++body.size;
+            }
+        }
+        inferIterations(flow, graph, header, &body);
+        bodies.push_back(std::move(body));
+    }
+    const auto numLoops = static_cast<int32_t>(bodies.size());
+    /** The smallest loop that contains the block, except the given loop. */
+    auto innermost = [&](const int32_t block, const int32_t except) {
+        int32_t result = -1;
+        for (int32_t i = 0; i < numLoops; ++i) {
+            if (i != except && bodies[i].contains[block] && (result < 0 || bodies[i].size < bodies[result].size)) {
+                result = i;
+            }
+        }
+        return result;
+    };
+    for (int32_t i = 0; i < numLoops; ++i) {
+        bodies[i].loop.parent = innermost(graph.blockAt[bodies[i].loop.header], i);
+    }
+    for (int32_t index = 0; index < numBlocks; ++index) {
+        graph.blocks[index].loop = innermost(index, -1);
+    }
+    /** The iterations of the loops from the innermost loop of the block up to the loop `outer`, or all of them. */
+    auto loopFactors = [&](const int32_t block, const int32_t outer, int64_t* coefficient,
+                           std::vector<std::string>* symbols) {
+        for (int32_t i = graph.blocks[block].loop; i >= 0; i = bodies[i].loop.parent) {
+            if (bodies[i].loop.iterations >= 0) {
+                *coefficient *= bodies[i].loop.iterations;
+            } else {
+                symbols->push_back(bodies[i].loop.symbol);
+            }
+            if (i == outer) {
+                break;
+            }
+        }
+    };
+
+    // The subroutines are executed once per call, their counts are resolved after the counts of their callers.
+    const auto numRoots = flow.roots.size();
+    std::vector<Polynomial> regionCounts(numRoots);
+    std::vector<bool> resolved(numRoots);
+    regionCounts[0] = {{{}, 1}};
+    resolved[0] = true;
+    if (handler >= 0 && numRoots > 1 && flow.roots[1] == handler) {
+        regionCounts[1] = {{{"INT"}, 1}};
+        resolved[1] = true;
+    }
+    auto blockCount = [&](const int32_t block) {
+        int64_t coefficient = 1;
+        std::vector<std::string> symbols;
+        loopFactors(block, -1, &coefficient, &symbols);
+        Polynomial count;
+        addTerms(&count, regionCounts[region[block]], coefficient, symbols);
+        return count;
+    };
+    while (std::find(resolved.begin(), resolved.end(), false) != resolved.end()) {
+        bool progress = false;
+        for (size_t root = 0; root < numRoots; ++root) {
+            if (resolved[root]) {
+                continue;
+            }
+            bool ready = true;
+            Polynomial count;
+            for (int32_t index = 0; index < numBlocks && ready; ++index) {
+                if (flow.callee(graph.last(index)) == flow.roots[root]) {
+                    ready = resolved[region[index]];
+                    if (ready) {
+                        addTerms(&count, blockCount(index), 1, {});
+                    }
+                }
+            }
+            if (ready) {
+                regionCounts[root] = count;
+                resolved[root] = true;
+                progress = true;
+            }
+        }
+        if (!progress) {
+            const auto root = std::find(resolved.begin(), resolved.end(), false) - resolved.begin();
+            regionCounts[root] = {{{"C" + std::to_string(flow.roots[root])}, 1}};
+            resolved[root] = true;
+        }
+    }
+
+    // The unit time of one call of each subroutine, including the subroutines it calls,
+    // resolved after the subroutines it calls. A recursive subroutine costs `T` followed by its location.
+    std::vector<Polynomial> regionCosts(numRoots);
+    std::fill(resolved.begin(), resolved.end(), false);
+    auto calleeRoot = [&](const int32_t block) -> int32_t {
+        const int32_t callee = flow.callee(graph.last(block));
+        const auto it = std::find(flow.roots.begin(), flow.roots.end(), callee);
+        return callee < 0 || it == flow.roots.end() ? -1 : static_cast<int32_t>(it - flow.roots.begin());
+    };
+    /** The unit time of one execution of the block and the subroutine it calls. */
+    auto blockTime = [&](const int32_t block) {
+        Polynomial time = {{{}, graph.blocks[block].cost}};
+        if (const int32_t callee = calleeRoot(block); callee >= 0) {
+            addTerms(&time, regionCosts[callee], 1, {});
+        }
+        return time;
+    };
+    while (std::find(resolved.begin(), resolved.end(), false) != resolved.end()) {
+        bool progress = false;
+        for (size_t root = 0; root < numRoots; ++root) {
+            if (resolved[root]) {
+                continue;
+            }
+            bool ready = true;
+            for (int32_t index = 0; index < numBlocks && ready; ++index) {
+                if (region[index] == static_cast<int32_t>(root)) {
+                    const int32_t callee = calleeRoot(index);
+                    ready = callee < 0 || resolved[callee];
+                }
+            }
+            if (ready) {
+                Polynomial cost;
+                for (int32_t index = 0; index < numBlocks; ++index) {
+                    if (region[index] == static_cast<int32_t>(root)) {
+                        int64_t coefficient = 1;
+                        std::vector<std::string> symbols;
+                        loopFactors(index, -1, &coefficient, &symbols);
+                        addTerms(&cost, blockTime(index), coefficient, symbols);
+                    }
+                }
+                regionCosts[root] = cost;
+                resolved[root] = true;
+                progress = true;
+            }
+        }
+        if (!progress) {
+            const auto root = std::find(resolved.begin(), resolved.end(), false) - resolved.begin();
+            regionCosts[root] = {{{"T" + std::to_string(flow.roots[root])}, 1}};
+            resolved[root] = true;
+        }
+    }
+
+    TimingAnalysis analysis;
+    Polynomial total;
+    for (int32_t index = 0; index < numBlocks; ++index) {
+        auto& block = graph.blocks[index];
+        const auto count = blockCount(index);
+        block.count = toExpression(count);
+        addTerms(&total, count, block.cost, {});
+    }
+    for (int32_t outer = 0; outer < numLoops; ++outer) {
+        auto& body = bodies[outer];
+        Polynomial cost;
+        for (int32_t index = 0; index < numBlocks; ++index) {
+            if (body.contains[index]) {
+                int64_t coefficient = 1;
+                std::vector<std::string> symbols;
+                loopFactors(index, outer, &coefficient, &symbols);
+                addTerms(&cost, blockTime(index), coefficient, symbols);
+            }
+        }
+        body.loop.cost = toExpression(cost);
+        analysis.loops.push_back(std::move(body.loop));
+    }
+    analysis.blocks = std::move(graph.blocks);
+    analysis.cost = toExpression(total);
+    return analysis;
+}
+
+}  // namespace mixal
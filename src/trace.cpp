@@ -0,0 +1,98 @@
+#include <map>
+#include <set>
+#include <sstream>
+#include "instructions.h"
+#include "trace.h"
+
+/**
+ * @file
+ * @brief Device timeline and its export.
+ */
+
+namespace mixal {
+
+DeviceTrace::DeviceTrace(const size_t capacity) : _events(capacity), _next(0), _size(0), _dropped(0) {}
+
+void DeviceTrace::clear() {
+    _next = 0;
+    _size = 0;
+    _dropped = 0;
+}
+
+std::vector<DeviceEvent> DeviceTrace::events() const {
+    std::vector<DeviceEvent> events;
+    events.reserve(_size);
+    const size_t first = _size < _events.size() ? 0 : _next;
+    for (size_t i = 0; i < _size; ++i) {
+        events.push_back(_events[(first + i) % _events.size()]);
+    }
+    return events;
+}
+
+namespace {
+
+const char* operationName(const uint8_t operation) {
+    switch (operation) {
+    case Instructions::IOC: return "IOC";
+    case Instructions::IN: return "IN";
+    case Instructions::OUT: return "OUT";
+    default: return "IO";
+    }
+}
+
+}  // namespace
+
+/** The track of the CPU is 0 and the track of unit `u` is `u + 1`. */
+void DeviceTrace::writeChromeTrace(std::ostream& out) const {
+    const auto events = this->events();
+    std::set<int32_t> units;
+    for (const auto& event : events) {
+        units.insert(event.unit);
+    }
+    out << R"({"displayTimeUnit":"ns","otherData":{"droppedEvents":)" << _dropped << R"(},"traceEvents":[)";
+    out << R"({"name":"process_name","ph":"M","pid":0,"tid":0,"args":{"name":"MIX"}})";
+    out << R"(,{"name":"thread_name","ph":"M","pid":0,"tid":0,"args":{"name":"CPU"}})";
+    for (const auto unit : units) {
+        out << R"(,{"name":"thread_name","ph":"M","pid":0,"tid":)" << unit + 1
+            << R"(,"args":{"name":"Unit )" << unit << R"("}})";
+    }
+    std::map<int32_t, DeviceEvent> started;
+    for (const auto& event : events) {
+        switch (event.type) {
+        case DeviceEventType::ISSUE:
+            out << R"(,{"name":")" << operationName(event.operation) << R"(","ph":"i","s":"t","ts":)"
+                << event.timestamp << R"(,"pid":0,"tid":0,"args":{"unit":)" << event.unit << "}}";
+            break;
+        case DeviceEventType::START:
+            started[event.unit] = event;
+            break;
+        case DeviceEventType::COMPLETE:
+            if (const auto it = started.find(event.unit); it != started.end()) {
+                out << R"(,{"name":")" << operationName(it->second.operation) << R"(","ph":"X","ts":)"
+                    << it->second.timestamp << R"(,"dur":)" << event.timestamp - it->second.timestamp
+                    << R"(,"pid":0,"tid":)" << event.unit + 1 << "}";
+                started.erase(it);
+            }
+            break;
+        case DeviceEventType::WAIT:
+        case DeviceEventType::POLL:
+            out << R"(,{"name":")" << (event.type == DeviceEventType::WAIT ? "wait" : "poll")
+                << R"(","ph":"X","ts":)" << event.timestamp << R"(,"dur":)" << event.duration
+                << R"(,"pid":0,"tid":0,"args":{"unit":)" << event.unit << "}}";
+            break;
+        }
+    }
+    for (const auto& [unit, event] : started) {
+        out << R"(,{"name":")" << operationName(event.operation) << R"(","ph":"B","ts":)"
+            << event.timestamp << R"(,"pid":0,"tid":)" << unit + 1 << "}";
+    }
+    out << "]}";
+}
+
+std::string DeviceTrace::toChromeTrace() const {
+    std::ostringstream out;
+    writeChromeTrace(out);
+    return out.str();
+}
+
+}  // namespace mixal
@@ -0,0 +1,169 @@
+#include <bitset>
+#include <sstream>
+#include <vector>
+#include "translator.h"
+
+/**
+ * @file
+ * @brief Translation of MIX programs to C++.
+ */
+
+namespace mixal {
+
+namespace {
+
+constexpr int NUM_MEMORY = Computer::NUM_MEMORY;
+
+bool isJump(const int operation) {
+    return operation == Instructions::JBUS || operation == Instructions::JRED ||
+           (Instructions::JMP <= operation && operation <= Instructions::JXN);
+}
+
+bool isHalt(const InstructionWord& word) {
+    return word.operation() == Instructions::HLT && word.field() == 2;
+}
+
+/** Whether the jump enters a subroutine that saves rJ with its first instruction. */
+bool isSubroutine(const Computer& machine, const InstructionWord& word) {
+    const int32_t target = word.addressValue();
+    return word.index() == 0 && 0 <= target && target < NUM_MEMORY &&
+           machine.memory[target].operation() == Instructions::STJ;
+}
+
+/** The locations that the control may reach, following the fallthroughs and the constant targets.
+ *
+ * The location after `JMP` is included when it calls a subroutine, since it is the return address.
+ */
+std::bitset<NUM_MEMORY> findReachable(const Computer& machine, const std::vector<int32_t>& roots) {
+    std::bitset<NUM_MEMORY> reachable;
+    std::vector<int32_t> stack;
+    auto push = [&](const int32_t location) {
+        if (0 <= location && location < NUM_MEMORY && !reachable.test(location)) {
+            reachable.set(location);
+            stack.push_back(location);
+        }
+    };
+    for (const auto root : roots) {
+        push(root);
+    }
+    while (!stack.empty()) {
+        const int32_t location = stack.back();
+        stack.pop_back();
+        const auto& word = machine.memory[location];
+        const int operation = word.operation();
+        if (isHalt(word) || (operation == Instructions::HLT && word.field() == 9)) {
+            continue;
+        }
+        if (isJump(operation) && word.index() == 0) {
+            push(word.addressValue());
+        }
+        if (operation == Instructions::JMP && word.field() <= 1) {
+            if (word.field() == 0 && isSubroutine(machine, word)) {
+                push(location + 1);
+            }
+            continue;
+        }
+        push(location + 1);
+    }
+    return reachable;
+}
+
+}  // namespace
+
+std::string translateToCpp(const Computer& machine, const int32_t entry, const TranslationOptions& options) {
+    std::vector<int32_t> roots = {entry};
+    if (machine.interruptVector() >= 0) {
+        roots.push_back(machine.interruptVector() + Computer::INTERRUPT_SAVE_SIZE);
+    }
+    // Any cell may be reached by a computed jump, so the stores are collected from the whole memory
+    // before any cell is removed from the translation.
+    std::bitset<NUM_MEMORY> written;
+    bool guarded = machine.interruptVector() >= 0;
+    for (int32_t location = 0; location < NUM_MEMORY; ++location) {
+        const auto& word = machine.memory[location];
+        const int operation = word.operation();
+        if (Instructions::STA <= operation && operation <= Instructions::STZ) {
+            if (word.index() != 0) {
+                guarded = true;
+            } else if (0 <= word.addressValue() && word.addressValue() < NUM_MEMORY) {
+                written.set(word.addressValue());
+            }
+        } else if (operation == Instructions::MOVE || operation == Instructions::IN) {
+            guarded = true;
+        }
+    }
+    const auto translated = findReachable(machine, roots) & ~written;
+
+    std::vector<int32_t> locations;
+    for (int32_t location = 0; location < NUM_MEMORY; ++location) {
+        if (translated.test(location)) {
+            locations.push_back(location);
+        }
+    }
+    std::ostringstream out;
+    out << "// Generated by mixal::translateToCpp from the entry " << entry << ", do not edit.\n";
+    out << "#include \"translated.h\"\n\n";
+    out << "extern \"C\" int64_t " << options.functionName << "(mixal::Computer& machine) {\n";
+    out << "    using R = mixal::TranslatedRuntime;\n";
+    out << "    static const mixal::InstructionWord W[] = {\n";
+    for (const auto location : locations) {
+        const auto& word = machine.memory[location];
+        out << "        mixal::InstructionWord(" << (word.negative ? "true" : "false") << ", "
+            << static_cast<int>(word.byte1) << ", " << static_cast<int>(word.byte2) << ", "
+            << static_cast<int>(word.byte3) << ", " << static_cast<int>(word.byte4) << ", "
+            << static_cast<int>(word.byte5) << "),  // " << location << "\n";
+    }
+    out << "    };\n";
+    out << "    int64_t native = 0;\n";
+    out << "    goto dispatch;\n";
+    for (size_t i = 0; i < locations.size(); ++i) {
+        const int32_t location = locations[i];
+        const auto& word = machine.memory[location];
+        const int operation = word.operation();
+        const int field = word.field();
+        out << "L" << location << ":\n";
+        if (guarded) {
+            out << "    if (!R::same(machine, " << location << ", W[" << i << "])) {\n"
+                << "        goto interpret;\n"
+                << "    }\n";
+        }
+        if (isHalt(word)) {
+            out << "    R::halt(machine);\n"
+                << "    return native + 1;\n";
+            continue;
+        }
+        out << "    R::execute<" << operation << ", " << field << ">(machine, W[" << i << "]);\n";
+        out << "    R::retire(machine, " << operation << ", " << field << ", "
+            << Instructions::getCost(static_cast<Instructions::Code>(operation), static_cast<uint8_t>(field)) << ");\n";
+        out << "    ++native;\n";
+        const int32_t target = word.addressValue();
+        if (isJump(operation) && word.index() == 0 && 0 <= target && target < NUM_MEMORY && translated.test(target)) {
+            out << "    if (R::line(machine) == " << target << ") {\n"
+                << "        goto L" << target << ";\n"
+                << "    }\n";
+        }
+        if (i + 1 < locations.size() && locations[i + 1] == location + 1) {
+            out << "    if (R::line(machine) != " << location + 1 << ") {\n"
+                << "        goto dispatch;\n"
+                << "    }\n";
+        } else {
+            out << "    goto dispatch;\n";
+        }
+    }
+    out << "dispatch:\n";
+    out << "    switch (R::line(machine)) {\n";
+    for (const auto location : locations) {
+        out << "    case " << location << ": goto L" << location << ";\n";
+    }
+    out << "    default: break;\n";
+    out << "    }\n";
+    out << "interpret:\n";
+    out << "    if (R::interpret(machine)) {\n"
+        << "        return native;\n"
+        << "    }\n";
+    out << "    goto dispatch;\n";
+    out << "}\n";
+    return out.str();
+}
+
+}  // namespace mixal
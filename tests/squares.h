@@ -0,0 +1,39 @@
+#ifndef TESTS_SQUARES_H_
+#define TESTS_SQUARES_H_
+
+#include <string>
+#include <vector>
+
+/** A program with a subroutine, indexed stores and output, translated by `translate_squares.cpp`. */
+inline const std::vector<std::string> SQUARES = {
+    "      ORIG 1000",
+    "START ENT1 0",
+    "LOOP  ENTA 0,1",
+    "      JMP  SQR",
+    "      STA  TABLE,1",
+    "      INC1 1",
+    "      CMP1 =20=",
+    "      JL   LOOP",
+    "      ENTA 0",
+    "      ENT1 19",
+    "SUM   ADD  TABLE,1",
+    "      DEC1 1",
+    "      J1NN SUM",
+    "      CHAR",
+    "      STA  BUF",
+    "      STX  BUF+1",
+    "      OUT  BUF(18)",
+    "      JBUS *(18)",
+    "      HLT",
+    "SQR   STJ  EXIT",
+    "      STA  TEMP",
+    "      MUL  TEMP",
+    "      SLAX 5",
+    "EXIT  JMP  *",
+    "TEMP  CON  0",
+    "TABLE ORIG *+20",
+    "BUF   ORIG *+24",
+    "      END  START",
+};
+
+#endif  // TESTS_SQUARES_H_
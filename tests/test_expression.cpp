@@ -247,7 +247,7 @@ TEST(TestExpression, test_const_expression) {
 
 TEST(TestExpression, test_expression_invalid_large_integer) {
     auto expression = mixal::Expression();
-    EXPECT_THROW(expression.parse("12345678901234", ""), mixal::ExpressionError);
+    EXPECT_THROW(expression.parse("12345678901234567890", ""), mixal::ExpressionError);
 }
 
 TEST(TestExpression, test_expression_evaluate_before_parse) {
@@ -34,6 +34,27 @@ TEST(TestInstructions, test_get_cost) {
     EXPECT_EQ(0, mixal::Instructions::getCost(mixal::Instructions::CON, 0));
 }
 
+TEST(TestInstructions, test_get_cost_by_field) {
+    EXPECT_EQ(10, mixal::Instructions::getCost(mixal::Instructions::HLT, 2));
+    EXPECT_EQ(2, mixal::Instructions::getCost(mixal::Instructions::INT, 9));
+    EXPECT_EQ(10, mixal::Instructions::getCost(mixal::Instructions::NUM, 10));
+    EXPECT_EQ(1, mixal::Instructions::getCost(mixal::Instructions::MOVE, 0));
+    EXPECT_EQ(21, mixal::Instructions::getCost(mixal::Instructions::MOVE, 10));
+    EXPECT_EQ(0, mixal::Instructions::getCost(mixal::Instructions::INVALID, 0));
+}
+
+TEST(TestInstructions, test_find_operation) {
+    for (const auto& operation : mixal::OPERATIONS) {
+        const auto found = mixal::Instructions::findOperation(operation.mnemonic);
+        ASSERT_NE(nullptr, found);
+        EXPECT_EQ(operation.mnemonic, found->mnemonic);
+    }
+    EXPECT_EQ(mixal::Instructions::JSJ, mixal::Instructions::findOperation("jsj")->code);
+    EXPECT_EQ(1, mixal::Instructions::findOperation("Jsj")->defaultField);
+    EXPECT_EQ(nullptr, mixal::Instructions::findOperation("JSJJ"));
+    EXPECT_EQ(nullptr, mixal::Instructions::findOperation(std::string_view("JSJ\0", 4)));
+}
+
 TEST(TestInstructions, test_get_instructions_coverage) {
     for (int i = 0; i < 37; ++i) {
         const char a = getValidChar(i);
@@ -24,7 +24,7 @@ TEST(TestMachineAddressTransfer, test_inca_with_index) {
 
 TEST(TestMachineAddressTransfer, test_inca_overflow) {
     mixal::Computer machine;
-    machine.rA.set(1073741814);
+    machine.rA.set(mixal::WordFormat::power(5) - 10);
     const auto result = mixal::Parser::parseLine("INCA 47", "", false);
     machine.executeSingle(result.word);
     EXPECT_EQ(37, machine.rA.value());
@@ -52,7 +52,7 @@ TEST(TestMachineAddressTransfer, test_deca_with_index) {
 
 TEST(TestMachineAddressTransfer, test_deca_overflow) {
     mixal::Computer machine;
-    machine.rA.set(-1073741814);
+    machine.rA.set(-mixal::WordFormat::power(5) + 10);
     const auto result = mixal::Parser::parseLine("DECA 47", "", false);
     machine.executeSingle(result.word);
     EXPECT_EQ(-37, machine.rA.value());
@@ -61,7 +61,7 @@ TEST(TestMachineAddressTransfer, test_deca_overflow) {
 
 TEST(TestMachineAddressTransfer, test_enta) {
     mixal::Computer machine;
-    machine.rA.set(-1073741814);
+    machine.rA.set(-mixal::WordFormat::power(5) + 10);
     const auto result = mixal::Parser::parseLine("ENTA 0", "", false);
     machine.executeSingle(result.word);
     EXPECT_EQ(0, machine.rA.value());
@@ -70,7 +70,7 @@ TEST(TestMachineAddressTransfer, test_enta) {
 
 TEST(TestMachineAddressTransfer, test_enta_with_index) {
     mixal::Computer machine;
-    machine.rA.set(1073741814);
+    machine.rA.set(mixal::WordFormat::power(5) - 10);
     machine.rI4.set(5);
     const auto result = mixal::Parser::parseLine("ENTA -5,4", "", false);
     machine.executeSingle(result.word);
@@ -81,7 +81,7 @@ TEST(TestMachineAddressTransfer, test_enta_with_index) {
 
 TEST(TestMachineAddressTransfer, test_enna) {
     mixal::Computer machine;
-    machine.rA.set(-1073741814);
+    machine.rA.set(-mixal::WordFormat::power(5) + 10);
     const auto result = mixal::Parser::parseLine("ENNA 0", "", false);
     machine.executeSingle(result.word);
     EXPECT_EQ(true, machine.rA.negative);
@@ -91,7 +91,7 @@ TEST(TestMachineAddressTransfer, test_enna) {
 
 TEST(TestMachineAddressTransfer, test_enna_with_index) {
     mixal::Computer machine;
-    machine.rA.set(1073741814);
+    machine.rA.set(mixal::WordFormat::power(5) - 10);
     machine.rI5.set(5);
     const auto result = mixal::Parser::parseLine("ENNA -5,5", "", false);
     machine.executeSingle(result.word);
@@ -121,7 +121,7 @@ TEST(TestMachineAddressTransfer, test_incx_with_index) {
 
 TEST(TestMachineAddressTransfer, test_incx_overflow) {
     mixal::Computer machine;
-    machine.rX.set(1073741814);
+    machine.rX.set(mixal::WordFormat::power(5) - 10);
     const auto result = mixal::Parser::parseLine("INCX 47", "", false);
     machine.executeSingle(result.word);
     EXPECT_EQ(37, machine.rX.value());
@@ -149,7 +149,7 @@ TEST(TestMachineAddressTransfer, test_decx_with_index) {
 
 TEST(TestMachineAddressTransfer, test_decx_overflow) {
     mixal::Computer machine;
-    machine.rX.set(-1073741814);
+    machine.rX.set(-mixal::WordFormat::power(5) + 10);
     const auto result = mixal::Parser::parseLine("DECX 47", "", false);
     machine.executeSingle(result.word);
     EXPECT_EQ(-37, machine.rX.value());
@@ -158,7 +158,7 @@ TEST(TestMachineAddressTransfer, test_decx_overflow) {
 
 TEST(TestMachineAddressTransfer, test_entx) {
     mixal::Computer machine;
-    machine.rX.set(-1073741814);
+    machine.rX.set(-mixal::WordFormat::power(5) + 10);
     const auto result = mixal::Parser::parseLine("ENTX 0", "", false);
     machine.executeSingle(result.word);
     EXPECT_EQ(0, machine.rX.value());
@@ -167,7 +167,7 @@ TEST(TestMachineAddressTransfer, test_entx) {
 
 TEST(TestMachineAddressTransfer, test_entx_with_index) {
     mixal::Computer machine;
-    machine.rX.set(1073741814);
+    machine.rX.set(mixal::WordFormat::power(5) - 10);
     machine.rI4.set(5);
     const auto result = mixal::Parser::parseLine("ENTX -5,4", "", false);
     machine.executeSingle(result.word);
@@ -178,7 +178,7 @@ TEST(TestMachineAddressTransfer, test_entx_with_index) {
 
 TEST(TestMachineAddressTransfer, test_ennx) {
     mixal::Computer machine;
-    machine.rX.set(-1073741814);
+    machine.rX.set(-mixal::WordFormat::power(5) + 10);
     const auto result = mixal::Parser::parseLine("ENNX 0", "", false);
     machine.executeSingle(result.word);
     EXPECT_EQ(true, machine.rX.negative);
@@ -188,7 +188,7 @@ TEST(TestMachineAddressTransfer, test_ennx) {
 
 TEST(TestMachineAddressTransfer, test_ennx_with_index) {
     mixal::Computer machine;
-    machine.rX.set(1073741814);
+    machine.rX.set(mixal::WordFormat::power(5) - 10);
     machine.rI5.set(5);
     const auto result = mixal::Parser::parseLine("ENNX -5,5", "", false);
     machine.executeSingle(result.word);
@@ -220,7 +220,7 @@ TEST(TestMachineAddressTransfer, test_inc3_overflow) {
     machine.rI3.set(4000);
     const auto result = mixal::Parser::parseLine("INC3 100", "", false);
     machine.executeSingle(result.word);
-    EXPECT_EQ(4, machine.rI3.value());
+    EXPECT_EQ(4100 % mixal::WordFormat::power(2), machine.rI3.value());
     EXPECT_FALSE(machine.overflow);
 }
 
@@ -256,7 +256,7 @@ TEST(TestMachineAddressTransfer, test_dec6_overflow) {
     machine.rI6.set(-4000);
     const auto result = mixal::Parser::parseLine("DEC6 100", "", false);
     machine.executeSingle(result.word);
-    EXPECT_EQ(-4, machine.rI6.value());
+    EXPECT_EQ(-(4100 % mixal::WordFormat::power(2)), machine.rI6.value());
     EXPECT_FALSE(machine.overflow);
 }
 
@@ -297,7 +297,7 @@ TEST(TestMachineAddressTransfer, test_ent5_with_index_and_overflow) {
     const auto result = mixal::Parser::parseLine("ENT5 100,4", "", false);
     machine.executeSingle(result.word);
     EXPECT_EQ(false, machine.rI5.negative);
-    EXPECT_EQ(4, machine.rI5.value());
+    EXPECT_EQ(4100 % mixal::WordFormat::power(2), machine.rI5.value());
     EXPECT_FALSE(machine.overflow);
 }
 
@@ -319,6 +319,6 @@ TEST(TestMachineAddressTransfer, test_enn6_with_index_and_overflow) {
     const auto result = mixal::Parser::parseLine("ENN6 100,5", "", false);
     machine.executeSingle(result.word);
     EXPECT_EQ(true, machine.rI6.negative);
-    EXPECT_EQ(-4, machine.rI6.value());
+    EXPECT_EQ(-(4100 % mixal::WordFormat::power(2)), machine.rI6.value());
     EXPECT_FALSE(machine.overflow);
 }
@@ -3,6 +3,10 @@
 #include "machine.h"
 #include "parser.h"
 
+constexpr uint8_t MAX_BYTE = mixal::BYTE_SIZE - 1;
+constexpr uint8_t HALF_BYTE = mixal::BYTE_SIZE / 2;
+constexpr uint8_t FLOAT_BIAS = mixal::ComputerWord::MIX_FLOAT_BIAS;
+
 TEST(TestMachineArithmetic, test_add_all_ra_bytes) {
     mixal::Computer machine;
     machine.rA.set(true, 1, 2, 3, 4, 5);
@@ -29,7 +33,7 @@ TEST(TestMachineArithmetic, test_add_all_ra_bytes) {
 
 TEST(TestMachineArithmetic, test_add_packed) {
     mixal::Computer machine;
-    machine.rA.set(false, 1234, 1, 150 / 64, 150 % 64);
+    machine.rA.set(false, 1234, 1, 150 / mixal::BYTE_SIZE, 150 % mixal::BYTE_SIZE);
     machine.memory[1000].set(false, 100, 5, 0, 50);
     const auto result = mixal::Parser::parseLine("ADD 1000", "", false);
     machine.executeSingle(result.word);
@@ -57,30 +61,30 @@ TEST(TestMachineArithmetic, test_add_negative_zero) {
 
 TEST(TestMachineArithmetic, test_add_overflow_positive) {
     mixal::Computer machine;
-    machine.rA.set(1000000000);
-    machine.memory[1000].set(1000000000);
+    machine.rA.set(mixal::WordFormat::power(5) - 1000);
+    machine.memory[1000].set(1234);
     const auto result = mixal::Parser::parseLine("ADD 1000", "", false);
     machine.executeSingle(result.word);
     EXPECT_EQ(0, machine.rA.negative);
-    EXPECT_EQ(926258176, machine.rA.value());
+    EXPECT_EQ(234, machine.rA.value());
     EXPECT_TRUE(machine.overflow);
 }
 
 TEST(TestMachineArithmetic, test_add_overflow_negative) {
     mixal::Computer machine;
-    machine.rA.set(-1000000000);
-    machine.memory[1000].set(-1000000000);
+    machine.rA.set(-mixal::WordFormat::power(5) + 1000);
+    machine.memory[1000].set(-1234);
     const auto result = mixal::Parser::parseLine("ADD 1000", "", false);
     machine.executeSingle(result.word);
     EXPECT_EQ(1, machine.rA.negative);
-    EXPECT_EQ(-926258176, machine.rA.value());
+    EXPECT_EQ(-234, machine.rA.value());
     EXPECT_TRUE(machine.overflow);
 }
 
 TEST(TestMachineArithmetic, test_sub_packed) {
     mixal::Computer machine;
     machine.rA.set(true, 1234, 0, 0, 9);
-    machine.memory[1000].set(true, 2000, 150 / 64, 150 % 64, 0);
+    machine.memory[1000].set(true, 2000, 150 / mixal::BYTE_SIZE, 150 % mixal::BYTE_SIZE, 0);
     const auto result = mixal::Parser::parseLine("SUB 1000", "", false);
     machine.executeSingle(result.word);
     EXPECT_EQ(0, machine.rA.negative);
@@ -92,7 +96,7 @@ TEST(TestMachineArithmetic, test_sub_packed) {
 TEST(TestMachineArithmetic, test_sub_overflow) {
     mixal::Computer machine;
     machine.rA.set(true, 0, 0, 0, 0, 1);
-    machine.memory[1000].set(false, 63, 63, 63, 63, 63);
+    machine.memory[1000].set(false, MAX_BYTE, MAX_BYTE, MAX_BYTE, MAX_BYTE, MAX_BYTE);
     const auto result = mixal::Parser::parseLine("SUB 1000", "", false);
     machine.executeSingle(result.word);
     EXPECT_EQ(true, machine.rA.negative);
@@ -138,7 +142,7 @@ TEST(TestMachineArithmetic, test_mul_one_byte) {
 
 TEST(TestMachineArithmetic, test_mul_packed) {
     mixal::Computer machine;
-    machine.rA.set(true, 50, 0, 112 / 64, 112 % 64, 4);
+    machine.rA.set(true, 50, 0, 112 / mixal::BYTE_SIZE, 112 % mixal::BYTE_SIZE, 4);
     machine.memory[1000].set(true, 2, 0, 0, 0, 0);
     const auto result = mixal::Parser::parseLine("MUL 1000", "", false);
     machine.executeSingle(result.word);
@@ -202,13 +206,14 @@ TEST(TestMachineArithmetic, test_div_packed) {
 
 TEST(TestMachineArithmetic, test_div_overflow) {
     mixal::Computer machine;
-    machine.rA.set(true, 64, 0, 0, 0, 0);
+    machine.rA.set(-7);
     machine.rX.set(false, 0, 0, 0, 0);
     machine.memory[1000].set(false, 0, 0, 0, 0, 3);
     const auto result = mixal::Parser::parseLine("DIV 1000", "", false);
     machine.executeSingle(result.word);
-    EXPECT_EQ(-357913941, machine.rA.value());
-    EXPECT_EQ(-1, machine.rX.value());
+    const auto range = mixal::WordFormat::power(5);
+    EXPECT_EQ(-(7 * range / 3 % range), machine.rA.value());
+    EXPECT_EQ(-(7 * range % 3), machine.rX.value());
     EXPECT_TRUE(machine.overflow);
 }
 
@@ -258,8 +263,8 @@ TEST(TestMachineArithmetic, float_add) {
 
 TEST(TestMachineArithmetic, float_add_overflow) {
     mixal::Computer machine;
-    machine.rA.set('+', 63, 63, 63, 63, 63);
-    machine.memory[1000].set('+', 63, 63, 63, 63, 63);
+    machine.rA.set('+', MAX_BYTE, MAX_BYTE, MAX_BYTE, MAX_BYTE, MAX_BYTE);
+    machine.memory[1000].set('+', MAX_BYTE, MAX_BYTE, MAX_BYTE, MAX_BYTE, MAX_BYTE);
     const auto result = mixal::Parser::parseLine("FADD 1000", "", false);
     machine.executeSingle(result.word);
     EXPECT_TRUE(machine.overflow);
@@ -278,8 +283,8 @@ TEST(TestMachineArithmetic, float_sub) {
 
 TEST(TestMachineArithmetic, float_sub_overflow) {
     mixal::Computer machine;
-    machine.rA.set('-', 63, 63, 63, 63, 63);
-    machine.memory[1000].set('+', 63, 63, 63, 63, 63);
+    machine.rA.set('-', MAX_BYTE, MAX_BYTE, MAX_BYTE, MAX_BYTE, MAX_BYTE);
+    machine.memory[1000].set('+', MAX_BYTE, MAX_BYTE, MAX_BYTE, MAX_BYTE, MAX_BYTE);
     const auto result = mixal::Parser::parseLine("FSUB 1000", "", false);
     machine.executeSingle(result.word);
     EXPECT_TRUE(machine.overflow);
@@ -298,8 +303,8 @@ TEST(TestMachineArithmetic, float_mul) {
 
 TEST(TestMachineArithmetic, float_mul_overflow) {
     mixal::Computer machine;
-    machine.rA.set('-', 63, 63, 63, 63, 63);
-    machine.memory[1000].set('+', 63, 63, 63, 63, 63);
+    machine.rA.set('-', MAX_BYTE, MAX_BYTE, MAX_BYTE, MAX_BYTE, MAX_BYTE);
+    machine.memory[1000].set('+', MAX_BYTE, MAX_BYTE, MAX_BYTE, MAX_BYTE, MAX_BYTE);
     const auto result = mixal::Parser::parseLine("FMUL 1000", "", false);
     machine.executeSingle(result.word);
     EXPECT_TRUE(machine.overflow);
@@ -319,7 +324,7 @@ TEST(TestMachineArithmetic, float_div) {
 TEST(TestMachineArithmetic, float_div_overflow) {
     mixal::Computer machine;
     machine.rA.set('-', 0, 32, 0, 0, 0);
-    machine.memory[1000].set('+', 63, 63, 63, 63, 63);
+    machine.memory[1000].set('+', MAX_BYTE, MAX_BYTE, MAX_BYTE, MAX_BYTE, MAX_BYTE);
     const auto result = mixal::Parser::parseLine("FDIV 1000", "", false);
     machine.executeSingle(result.word);
     EXPECT_TRUE(machine.overflow);
@@ -331,4 +336,67 @@ TEST(TestMachineArithmetic, float_div_runtime_error) {
     machine.memory[1000].set(0.0);
     const auto result = mixal::Parser::parseLine("FDIV 1000", "", false);
     ASSERT_THROW(machine.executeSingle(result.word), mixal::RuntimeError);
-}
\ No newline at end of file
+}
+TEST(TestMachineArithmetic, float_add_exact) {
+    mixal::Computer machine;
+    machine.rA.set(false, 33, 1, 0, 0, 0);
+    machine.memory[1000].set(false, 29, HALF_BYTE, 0, 0, 0);
+    const auto result = mixal::Parser::parseLine("FADD 1000", "", false);
+    machine.executeSingle(result.word);
+    EXPECT_EQ(mixal::ComputerWord(false, 33, 1, 0, 0, 1), machine.rA);
+    machine.executeSingle(result.word);
+    EXPECT_EQ(mixal::ComputerWord(false, 33, 1, 0, 0, 1), machine.rA);
+    machine.memory[1000].set(false, 27, MAX_BYTE, MAX_BYTE, MAX_BYTE, MAX_BYTE);
+    machine.executeSingle(result.word);
+    EXPECT_EQ(mixal::ComputerWord(false, 33, 1, 0, 0, 1), machine.rA);
+    machine.rA.set(false, 20, 0, 0, 0, 3);
+    machine.memory[1000].set(false, 19, 0, 0, 1, 0);
+    machine.executeSingle(result.word);
+    EXPECT_EQ(mixal::ComputerWord(false, 17, 4, 0, 0, 0), machine.rA);
+    EXPECT_FALSE(machine.overflow);
+}
+
+TEST(TestMachineArithmetic, float_sub_cancel) {
+    mixal::Computer machine;
+    machine.rA.set(true, 40, 5, 6, 7, 8);
+    machine.memory[1000].set(true, 40, 5, 6, 7, 8);
+    const auto result = mixal::Parser::parseLine("FSUB 1000", "", false);
+    machine.executeSingle(result.word);
+    EXPECT_EQ(mixal::ComputerWord(false, 0, 0, 0, 0, 0), machine.rA);
+    machine.rA.set(false, 33, 1, 0, 0, 0);
+    machine.memory[1000].set(false, 29, 1, 0, 0, 0);
+    machine.executeSingle(result.word);
+    EXPECT_EQ(mixal::ComputerWord(false, 32, MAX_BYTE, MAX_BYTE, MAX_BYTE, MAX_BYTE), machine.rA);
+    EXPECT_FALSE(machine.overflow);
+}
+
+TEST(TestMachineArithmetic, float_mul_exact) {
+    mixal::Computer machine;
+    machine.rA.set(false, FLOAT_BIAS + 1, 2, 0, 0, 0);
+    machine.memory[1000].set(true, FLOAT_BIAS + 1, 3, 0, 0, 0);
+    const auto result = mixal::Parser::parseLine("FMUL 1000", "", false);
+    machine.executeSingle(result.word);
+    EXPECT_EQ(mixal::ComputerWord(true, FLOAT_BIAS + 1, 6, 0, 0, 0), machine.rA);
+    EXPECT_FALSE(machine.overflow);
+    machine.rA.set(false, 1, 1, 0, 0, 0);
+    machine.memory[1000].set(false, 1, 1, 0, 0, 0);
+    machine.executeSingle(result.word);
+    EXPECT_EQ(mixal::ComputerWord(false, mixal::BYTE_SIZE + 1 - FLOAT_BIAS, 1, 0, 0, 0), machine.rA);
+    EXPECT_TRUE(machine.overflow);
+}
+
+TEST(TestMachineArithmetic, float_div_exact) {
+    mixal::Computer machine;
+    machine.rA.set(false, 33, 1, 0, 0, 0);
+    machine.memory[1000].set(false, 33, 3, 0, 0, 0);
+    const auto result = mixal::Parser::parseLine("FDIV 1000", "", false);
+    machine.executeSingle(result.word);
+    constexpr uint8_t third = mixal::BYTE_SIZE / 3;
+    EXPECT_EQ(mixal::ComputerWord(false, FLOAT_BIAS, third, third, third, third), machine.rA);
+    machine.rA.set(true, 33, 2, 0, 0, 0);
+    machine.memory[1000].set(false, 35, 0, 0, 3, 0);
+    machine.executeSingle(result.word);
+    constexpr uint8_t twoThirds = mixal::BYTE_SIZE * 2 / 3;
+    EXPECT_EQ(mixal::ComputerWord(true, FLOAT_BIAS, twoThirds, twoThirds, twoThirds, twoThirds + 1), machine.rA);
+    EXPECT_FALSE(machine.overflow);
+}
@@ -62,3 +62,22 @@ TEST(TestMachineComparison, test_fcmp) {
     machine.executeSingle(result.word);
     EXPECT_EQ(mixal::ComparisonIndicator::LESS, machine.comparison);
 }
+
+TEST(TestMachineComparison, test_fcmp_exact) {
+    mixal::Computer machine;
+    machine.rA.set(false, 33, 1, 0, 0, 0);
+    machine.memory[1000].set(false, 34, 0, 1, 0, 0);
+    const auto result = mixal::Parser::parseLine("FCMP 1000", "", false);
+    machine.executeSingle(result.word);
+    EXPECT_EQ(mixal::ComparisonIndicator::EQUAL, machine.comparison);
+    machine.memory[1000].set(false, 34, 0, 1, 0, 1);
+    machine.executeSingle(result.word);
+    EXPECT_EQ(mixal::ComparisonIndicator::LESS, machine.comparison);
+    machine.rA.set(true, 0, 0, 0, 0, 0);
+    machine.memory[1000].set(false, 10, 0, 0, 0, 0);
+    machine.executeSingle(result.word);
+    EXPECT_EQ(mixal::ComparisonIndicator::EQUAL, machine.comparison);
+    machine.memory[1000].set(true, 0, 0, 0, 0, 1);
+    machine.executeSingle(result.word);
+    EXPECT_EQ(mixal::ComparisonIndicator::GREATER, machine.comparison);
+}
@@ -19,8 +19,9 @@ TEST(TestMachineConversion, test_num_overflow) {
     machine.rX.set(false, 37, 57, 47, 30, 30);
     const auto result = mixal::Parser::parseLine("NUM", "", false);
     machine.executeSingle(result.word);
-    EXPECT_EQ(249301284, machine.rA.value());
-    EXPECT_TRUE(machine.overflow);
+    constexpr int64_t digits = 9912977700;
+    EXPECT_EQ(digits % mixal::WordFormat::power(5), machine.rA.value());
+    EXPECT_EQ(digits >= mixal::WordFormat::power(5), machine.overflow);
 }
 
 TEST(TestMachineConversion, test_char) {
@@ -0,0 +1,115 @@
+#include <iostream>
+#include <gtest/gtest.h>
+#include "machine.h"
+
+TEST(TestMachineCounters, test_scalar_counters) {
+    mixal::Computer machine;
+    machine.loadCodes({
+        "     ORIG 3000",
+        "     ENT1 3",
+        "LOOP INCA 1",
+        "     DEC1 1",
+        "     J1P  LOOP",
+        "     HLT",
+    });
+    machine.executeUntilHalt();
+    auto counters = machine.performanceCounters();
+    EXPECT_EQ(10, machine.steps());
+    EXPECT_EQ(10, counters.steps);
+    EXPECT_EQ(machine.elapsed(), counters.elapsed);
+    EXPECT_EQ(2, counters.jumpsTaken);
+    EXPECT_EQ(1, counters.jumpsNotTaken);
+    EXPECT_TRUE(counters.instructions.empty());
+    EXPECT_EQ(21u, counters.deviceWaitCycles.size());
+}
+
+TEST(TestMachineCounters, test_histogram) {
+    mixal::Computer machine;
+    machine.setCountersEnabled(true);
+    EXPECT_TRUE(machine.countersEnabled());
+    machine.loadCodes({
+        "     ORIG 3000",
+        "     ENT1 3",
+        "LOOP LDA  1000",
+        "     STA  1001",
+        "     DEC1 1",
+        "     J1P  LOOP",
+        "     HLT",
+    });
+    machine.executeUntilHalt();
+    auto counters = machine.performanceCounters();
+    EXPECT_EQ(3, counters.instructionCount(mixal::Instructions::LDA, 5));
+    EXPECT_EQ(3, counters.instructionCount(mixal::Instructions::J1P, 2));
+    EXPECT_EQ(0, counters.instructionCount(mixal::Instructions::NOP, 64));
+    EXPECT_EQ(3, counters.memoryReads);
+    EXPECT_EQ(3, counters.memoryWrites);
+    EXPECT_EQ(2, counters.jumpsTaken);
+    EXPECT_EQ(1, counters.jumpsNotTaken);
+    machine.resetPerformanceCounters();
+    EXPECT_EQ(0, machine.performanceCounters().instructionCount(mixal::Instructions::LDA, 5));
+    EXPECT_TRUE(machine.countersEnabled());
+    machine.setCountersEnabled(false);
+    EXPECT_FALSE(machine.countersEnabled());
+}
+
+TEST(TestMachineCounters, test_overflow_and_move) {
+    mixal::Computer machine;
+    machine.setCountersEnabled(true);
+    machine.loadCodes({
+        "     ORIG 3000",
+        "     LDA  1000",
+        "     ADD  1000",
+        "     JNOV *+1",
+        "     ENT1 2000",
+        "     MOVE 1000(10)",
+        "     HLT",
+    });
+    machine.memory[1000].set(mixal::WordFormat::power(5) / 2 + 1);
+    machine.executeUntilHalt();
+    auto counters = machine.performanceCounters();
+    EXPECT_EQ(1, counters.overflows);
+    EXPECT_EQ(0, counters.jumpsTaken);
+    EXPECT_EQ(1, counters.jumpsNotTaken);
+    EXPECT_EQ(12, counters.memoryReads);
+    EXPECT_EQ(10, counters.memoryWrites);
+}
+
+TEST(TestMachineCounters, test_device_counters) {
+    mixal::Computer machine;
+    machine.loadCodes({
+        "     ORIG 3000",
+        "     OUT  1000(18)",
+        "     OUT  1000(18)",
+        "     OUT  1000(18)",
+        "     HLT",
+    });
+    machine.executeUntilHalt();
+    auto counters = machine.performanceCounters();
+    EXPECT_EQ(72, counters.deviceOutputWords[18]);
+    EXPECT_EQ(72, counters.memoryReads);
+    EXPECT_GT(counters.deviceWaitCycles[18], 0);
+    EXPECT_EQ(0, counters.deviceInputWords[18]);
+}
+
+TEST(TestMachineCounters, test_derived_counters_without_histogram) {
+    mixal::Computer machine;
+    machine.loadCodes({
+        "     ORIG 3000",
+        "     ENT1 3",
+        "LOOP LDA  1000",
+        "     STA  1001",
+        "     DEC1 1",
+        "     J1P  LOOP",
+        "     ENT1 2000",
+        "     MOVE 1000(10)",
+        "     HLT",
+    });
+    machine.executeUntilHalt();
+    const auto counters = machine.performanceCounters();
+    EXPECT_TRUE(counters.instructions.empty());
+    EXPECT_EQ(13, counters.memoryReads);
+    EXPECT_EQ(13, counters.memoryWrites);
+    EXPECT_EQ(10, counters.movedWords);
+    EXPECT_EQ(2, counters.jumpsTaken);
+    EXPECT_EQ(1, counters.jumpsNotTaken);
+}
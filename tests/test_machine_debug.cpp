@@ -0,0 +1,139 @@
+#include <iostream>
+#include <limits>
+#include <gtest/gtest.h>
+#include "machine.h"
+
+TEST(TestMachineDebug, test_breakpoint) {
+    mixal::Computer machine;
+    machine.loadCodes({
+        "     ORIG 3000",
+        "     ENT1 3",
+        "LOOP INCA 1",
+        "     DEC1 1",
+        "     J1P  LOOP",
+        "     HLT",
+    });
+    machine.setBreakpoint(3001);
+    EXPECT_TRUE(machine.hasBreakpoint(3001));
+    auto info = machine.runUntilBreak();
+    EXPECT_EQ(mixal::StopReason::BREAKPOINT, info.reason);
+    EXPECT_EQ(3001, info.line);
+    EXPECT_EQ(0, machine.rA.value());
+    info = machine.runUntilBreak();
+    EXPECT_EQ(mixal::StopReason::BREAKPOINT, info.reason);
+    EXPECT_EQ(1, machine.rA.value());
+    machine.clearBreakpoint(3001);
+    EXPECT_FALSE(machine.hasBreakpoint(3001));
+    info = machine.runUntilBreak();
+    EXPECT_EQ(mixal::StopReason::HALT, info.reason);
+    EXPECT_EQ(3, machine.rA.value());
+}
+
+TEST(TestMachineDebug, test_conditional_breakpoint) {
+    mixal::Computer machine;
+    machine.loadCodes({
+        "     ORIG 3000",
+        "     ENT1 5",
+        "LOOP INCA 1",
+        "     DEC1 1",
+        "     J1P  LOOP",
+        "     HLT",
+    });
+    machine.setBreakpoint(3002, {mixal::RegisterName::I1, mixal::ConditionOperator::LESS_EQUAL, 2});
+    auto info = machine.runUntilBreak();
+    EXPECT_EQ(mixal::StopReason::BREAKPOINT, info.reason);
+    EXPECT_EQ(2, machine.rI1.value());
+    EXPECT_EQ(4, machine.rA.value());
+    machine.clearBreakpoints();
+    info = machine.runUntilBreak();
+    EXPECT_EQ(mixal::StopReason::HALT, info.reason);
+}
+
+TEST(TestMachineDebug, test_conditional_breakpoint_full_word) {
+    const std::vector<std::string> codes = {
+        "     ORIG 3000",
+        "     LDA  BIG",
+        "     HLT",
+        "BIG  CON  0",
+    };
+    constexpr mixal::WordValue MAX_WORD = mixal::WordFormat::power(5) - 1;
+    mixal::Computer machine;
+    machine.loadCodes(codes);
+    machine.memory[3002].set(MAX_WORD);
+    machine.setBreakpoint(3001, {mixal::RegisterName::A, mixal::ConditionOperator::EQUAL, MAX_WORD});
+    EXPECT_EQ(mixal::StopReason::BREAKPOINT, machine.runUntilBreak().reason);
+
+    // The words of the decimal MIX do not fit in 32 bits.
+    mixal::Computer wide;
+    wide.loadCodes(codes);
+    wide.memory[3002].set(MAX_WORD);
+    wide.setBreakpoint(3001, {mixal::RegisterName::A, mixal::ConditionOperator::GREATER,
+                              std::numeric_limits<int32_t>::max()});
+    const auto expected = MAX_WORD > std::numeric_limits<int32_t>::max() ?
+                          mixal::StopReason::BREAKPOINT : mixal::StopReason::HALT;
+    EXPECT_EQ(expected, wide.runUntilBreak().reason);
+}
+
+TEST(TestMachineDebug, test_watchpoint) {
+    mixal::Computer machine;
+    machine.loadCodes({
+        "     ORIG 3000",
+        "     LDA  1000",
+        "     STA  1001",
+        "     LDX  1001",
+        "     HLT",
+    });
+    machine.memory[1000].set(42);
+    machine.setWatchpoint(1001, true, true);
+    auto info = machine.runUntilBreak();
+    EXPECT_EQ(mixal::StopReason::WATCH_WRITE, info.reason);
+    EXPECT_EQ(3001, info.line);
+    EXPECT_EQ(1001, info.address);
+    EXPECT_EQ(42, machine.memory[1001].value());
+    info = machine.runUntilBreak();
+    EXPECT_EQ(mixal::StopReason::WATCH_READ, info.reason);
+    EXPECT_EQ(3002, info.line);
+    machine.clearWatchpoints();
+    info = machine.runUntilBreak();
+    EXPECT_EQ(mixal::StopReason::HALT, info.reason);
+}
+
+TEST(TestMachineDebug, test_watchpoint_move) {
+    mixal::Computer machine;
+    machine.loadCodes({
+        "     ORIG 3000",
+        "     ENT1 2000",
+        "     MOVE 1000(3)",
+        "     HLT",
+    });
+    machine.setWatchpoint(2002);
+    auto info = machine.runUntilBreak();
+    EXPECT_EQ(mixal::StopReason::WATCH_WRITE, info.reason);
+    EXPECT_EQ(2002, info.address);
+    machine.clearWatchpoint(2002);
+    EXPECT_EQ(mixal::StopReason::HALT, machine.runUntilBreak().reason);
+}
+
+TEST(TestMachineDebug, test_self_loop_and_error) {
+    mixal::Computer machine;
+    machine.loadCodes(std::vector<std::string>({
+        "     ORIG 3000",
+        "LOOP JMP  LOOP",
+    }));
+    EXPECT_EQ(mixal::StopReason::SELF_LOOP, machine.runUntilBreak().reason);
+    machine.loadCodes(std::vector<std::string>({
+        "     ORIG 3000",
+        "     LDA  -1",
+    }));
+    const auto info = machine.runUntilBreak();
+    EXPECT_EQ(mixal::StopReason::ERROR, info.reason);
+    EXPECT_EQ(3000, info.line);
+    EXPECT_FALSE(info.message.empty());
+}
+
+TEST(TestMachineDebug, test_invalid_locations) {
+    mixal::Computer machine;
+    EXPECT_THROW(machine.setBreakpoint(-1), mixal::RuntimeError);
+    EXPECT_THROW(machine.setWatchpoint(mixal::Computer::NUM_MEMORY), mixal::RuntimeError);
+    EXPECT_FALSE(machine.hasBreakpoint(mixal::Computer::NUM_MEMORY));
+}
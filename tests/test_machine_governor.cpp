@@ -0,0 +1,123 @@
+#include <iostream>
+#include <gtest/gtest.h>
+#include "machine.h"
+
+TEST(TestMachineGovernor, test_printed_lines) {
+    mixal::Computer machine;
+    machine.loadCodes({
+        "     ORIG 3000",
+        "LOOP OUT  1000(18)",
+        "     JMP  LOOP",
+    });
+    mixal::ResourceLimits limits;
+    limits.printedLines = 5;
+    machine.setResourceLimits(limits);
+    const auto info = machine.run();
+    EXPECT_EQ(mixal::StopReason::RESOURCE_LIMIT, info.reason);
+    EXPECT_EQ(mixal::ResourceKind::PRINTED_LINES, info.resource);
+    EXPECT_EQ(3000, info.line);
+    EXPECT_EQ(5, machine.resourceUsage().printedLines);
+}
+
+TEST(TestMachineGovernor, test_output_blocks) {
+    mixal::Computer machine;
+    machine.loadCodes({
+        "     ORIG 3000",
+        "     OUT  1000(1)",
+        "     OUT  1000(9)",
+        "     OUT  1000(17)",
+        "     OUT  1000(1)",
+        "     HLT",
+    });
+    mixal::ResourceLimits limits;
+    limits.tapeBlocks = 1;
+    limits.diskBlocks = 1;
+    limits.punchedCards = 1;
+    machine.setResourceLimits(limits);
+    const auto info = machine.run();
+    EXPECT_EQ(mixal::ResourceKind::TAPE_BLOCKS, info.resource);
+    EXPECT_EQ(3003, info.line);
+    EXPECT_EQ(1, machine.resourceUsage().tapeBlocks);
+    EXPECT_EQ(1, machine.resourceUsage().diskBlocks);
+    EXPECT_EQ(1, machine.resourceUsage().punchedCards);
+    machine.clearResourceLimits();
+    EXPECT_EQ(mixal::StopReason::HALT, machine.run().reason);
+    EXPECT_EQ(2, machine.resourceUsage().tapeBlocks);
+}
+
+TEST(TestMachineGovernor, test_moved_words) {
+    mixal::Computer machine;
+    machine.loadCodes({
+        "     ORIG 3000",
+        "     ENT1 2000",
+        "     MOVE 1000(30)",
+        "     MOVE 1000(30)",
+        "     HLT",
+    });
+    mixal::ResourceLimits limits;
+    limits.movedWords = 50;
+    machine.setResourceLimits(limits);
+    const auto info = machine.run();
+    EXPECT_EQ(mixal::ResourceKind::MOVED_WORDS, info.resource);
+    EXPECT_EQ(3002, info.line);
+    EXPECT_EQ(30, machine.resourceUsage().movedWords);
+}
+
+TEST(TestMachineGovernor, test_elapsed_and_wall_clock) {
+    mixal::Computer machine;
+    machine.loadCodes({
+        "     ORIG 3000",
+        "LOOP INCA 1",
+        "     JMP  LOOP",
+    });
+    mixal::ResourceLimits limits;
+    limits.elapsed = 1000;
+    machine.setResourceLimits(limits);
+    auto info = machine.run();
+    EXPECT_EQ(mixal::ResourceKind::ELAPSED, info.resource);
+    EXPECT_EQ(1000, machine.elapsed());
+    limits = mixal::ResourceLimits();
+    limits.wallClockMilliseconds = 0;
+    limits.wallClockCheckInterval = 16;
+    machine.setResourceLimits(limits);
+    info = machine.run();
+    EXPECT_EQ(mixal::StopReason::RESOURCE_LIMIT, info.reason);
+    EXPECT_EQ(mixal::ResourceKind::WALL_CLOCK, info.resource);
+    EXPECT_EQ(1000, machine.elapsed());
+}
+
+TEST(TestMachineGovernor, test_reset_usage) {
+    mixal::Computer machine;
+    machine.loadCodes({
+        "     ORIG 3000",
+        "     OUT  1000(18)",
+        "     HLT",
+    });
+    machine.executeUntilHalt();
+    EXPECT_EQ(1, machine.resourceUsage().printedLines);
+    machine.reset();
+    EXPECT_EQ(0, machine.resourceUsage().printedLines);
+}
+
+TEST(TestMachineGovernor, test_limits_without_run) {
+    mixal::Computer machine;
+    machine.loadCodes({
+        "     ORIG 3000",
+        "LOOP OUT  1000(18)",
+        "     JMP  LOOP",
+    });
+    mixal::ResourceLimits limits;
+    limits.printedLines = 3;
+    machine.setResourceLimits(limits);
+    try {
+        machine.executeUntilHalt();
+        FAIL() << "The limit should have been enforced";
+    } catch (const mixal::RuntimeError& error) {
+        EXPECT_EQ(3000, error.line());
+        EXPECT_EQ(std::string("Resource limit exceeded: printed lines"), error.what());
+    }
+    EXPECT_EQ(3, machine.resourceUsage().printedLines);
+    EXPECT_THROW(machine.executeUntilHaltOrSelfLoop(), mixal::RuntimeError);
+    EXPECT_THROW(machine.executeUntilSelfLoop(), mixal::RuntimeError);
+    EXPECT_EQ(3, machine.resourceUsage().printedLines);
+}
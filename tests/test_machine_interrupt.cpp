@@ -0,0 +1,121 @@
+#include <cstdlib>
+#include <memory>
+#include <gtest/gtest.h>
+#include "machine.h"
+
+TEST(TestMachineInterrupt, test_save_and_restore) {
+    mixal::Computer machine;
+    machine.setInterruptVector(100);
+    machine.loadCodes({
+        "      ORIG 110",
+        "      LDA  COUNT",
+        "      INCA 1",
+        "      STA  COUNT",
+        "      ENT1 0",
+        "      INT",
+        "COUNT CON  0",
+        "      ORIG 3000",
+        "START ENTA 7",
+        "      ENT1 -5",
+        "      ENTX 1",
+        "      CMPX =2=",
+        "      OUT  1000(18)",
+        "WAIT  LDX  COUNT",
+        "      JXZ  WAIT",
+        "      HLT",
+        "      END  START",
+    });
+    const auto info = machine.run();
+    EXPECT_EQ(mixal::StopReason::HALT, info.reason);
+    EXPECT_EQ(1, machine.memory[115].value());
+    EXPECT_EQ(7, machine.rA.value());
+    EXPECT_EQ(-5, machine.rI1.value());
+    EXPECT_EQ(1, machine.rX.value());
+    EXPECT_EQ(mixal::ComparisonIndicator::LESS, machine.comparison);
+    EXPECT_FALSE(machine.inControlState());
+    EXPECT_EQ(7, machine.memory[100].value());
+    EXPECT_EQ(-5, machine.memory[102].value());
+    EXPECT_EQ(18, machine.memory[109].byte3);
+    EXPECT_EQ(0, machine.memory[109].byte5);
+    const int32_t returned = machine.memory[109].bytes12();
+    EXPECT_TRUE(returned == 3005 || returned == 3006) << returned;
+}
+
+TEST(TestMachineInterrupt, test_invalid_usage) {
+    mixal::Computer machine;
+    EXPECT_THROW(machine.setInterruptVector(mixal::Computer::NUM_MEMORY - 10), mixal::RuntimeError);
+    machine.loadCodes(std::vector<std::string>({
+        "      ORIG 3000",
+        "      INT",
+    }));
+    auto info = machine.run();
+    EXPECT_EQ(mixal::StopReason::ERROR, info.reason);
+    machine.setInterruptVector(100);
+    EXPECT_EQ(100, machine.interruptVector());
+    machine.loadCodes(std::vector<std::string>({
+        "      ORIG 3000",
+        "      INT",
+    }));
+    info = machine.run();
+    EXPECT_EQ(mixal::StopReason::ERROR, info.reason);
+    EXPECT_EQ(3000, info.line);
+    machine.setInterruptVector(-1);
+    EXPECT_EQ(-1, machine.interruptVector());
+}
+
+TEST(TestMachineInterrupt, test_overlapped_output) {
+    constexpr int NUM_BLOCKS = 20;
+    auto run = [](const bool interrupts, int* blocks) {
+        mixal::Computer machine;
+        machine.registerDevice(5, [blocks]() {
+            return std::make_unique<mixal::IODeviceCallback>(
+                100, nullptr, [blocks](std::span<const mixal::ComputerWord>) { ++*blocks; }, nullptr, 0.01);
+        });
+        if (interrupts) {
+            machine.setInterruptVector(100);
+            machine.loadCodes({
+                "      ORIG 110",
+                "      LDA  LEFT",
+                "      JAZ  DONE",
+                "      DECA 1",
+                "      STA  LEFT",
+                "      OUT  1000(5)",
+                "DONE  INT",
+                "LEFT  CON  19",
+                "      ORIG 3000",
+                "START OUT  1000(5)",
+                "      ENT1 1000",
+                "CALC  DEC1 1",
+                "      J1P  CALC",
+                "WAIT  LDA  LEFT",
+                "      JANZ WAIT",
+                "      HLT",
+                "      END  START",
+            });
+        } else {
+            machine.loadCodes({
+                "      ORIG 3000",
+                "      ENT2 20",
+                "NEXT  OUT  1000(5)",
+                "      JBUS *(5)",
+                "      DEC2 1",
+                "      J2P  NEXT",
+                "      ENT1 1000",
+                "CALC  DEC1 1",
+                "      J1P  CALC",
+                "      HLT",
+            });
+        }
+        const auto info = machine.run();
+        EXPECT_EQ(mixal::StopReason::HALT, info.reason) << info.message;
+        return machine.elapsed();
+    };
+    srand(42);
+    int serialBlocks = 0, overlappedBlocks = 0;
+    const int64_t serial = run(false, &serialBlocks);
+    const int64_t overlapped = run(true, &overlappedBlocks);
+    EXPECT_EQ(NUM_BLOCKS, serialBlocks);
+    EXPECT_EQ(NUM_BLOCKS, overlappedBlocks);
+    EXPECT_GT(serial, 3000);
+    EXPECT_LT(overlapped * 4, serial * 3);
+}
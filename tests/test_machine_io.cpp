@@ -1,4 +1,8 @@
 #include <iostream>
+#include <filesystem>
+#include <fstream>
+#include <span>
+#include <sstream>
 #include <gtest/gtest.h>
 #include "machine.h"
 
@@ -122,3 +126,479 @@ TEST(TestMachineIO, test_io_invalid_address) {
     }));
     EXPECT_THROW(machine.executeUntilHalt(), mixal::RuntimeError);
 }
+
+TEST(TestMachineIO, test_paged_storage) {
+    mixal::PagedStorage storage(4096);
+    EXPECT_EQ(4096, storage.size());
+    EXPECT_EQ(0, storage.numAllocatedPages());
+    EXPECT_EQ(0, storage.get(100).value());
+    EXPECT_EQ(0, storage.numAllocatedPages());
+    storage.at(100).set(42);
+    EXPECT_EQ(42, storage.get(100).value());
+    EXPECT_EQ(1, storage.numAllocatedPages());
+    storage.at(5000).set(43);
+    EXPECT_EQ(5001, storage.size());
+    EXPECT_EQ(2, storage.numAllocatedPages());
+    const mixal::PagedStorage copied = storage;
+    storage.at(5000).set(0);
+    EXPECT_EQ(43, copied.get(5000).value());
+    EXPECT_THROW(storage.at(-1), std::out_of_range);
+    storage.clear(4096);
+    EXPECT_EQ(4096, storage.size());
+    EXPECT_EQ(0, storage.numAllocatedPages());
+}
+
+TEST(TestMachineIO, test_paged_storage_blocks) {
+    mixal::PagedStorage storage(1000);
+    std::vector<mixal::ComputerWord> words(300);
+    for (int i = 0; i < 300; ++i) {
+        words[i].set(i + 1);
+    }
+    storage.store(200, words.data(), 300);
+    EXPECT_EQ(2, storage.numAllocatedPages());
+    EXPECT_EQ(1000, storage.size());
+    EXPECT_EQ(1, storage.get(200).value());
+    EXPECT_EQ(300, storage.get(499).value());
+    std::vector<mixal::ComputerWord> loaded(600, mixal::ComputerWord(9));
+    storage.load(-50, loaded.data(), 600);
+    EXPECT_EQ(0, loaded[0].value());
+    EXPECT_EQ(0, loaded[249].value());
+    EXPECT_EQ(1, loaded[250].value());
+    EXPECT_EQ(300, loaded[549].value());
+    EXPECT_EQ(0, loaded[550].value());
+    storage.store(1020, words.data(), 10);
+    EXPECT_EQ(1030, storage.size());
+    EXPECT_THROW(storage.store(-1, words.data(), 1), std::out_of_range);
+}
+
+TEST(TestMachineIO, test_block_exceeds_memory) {
+    mixal::Computer machine;
+    machine.loadCodes(std::vector<std::string>({
+        "     ORIG 3000",
+        "     OUT  " + std::to_string(mixal::Computer::NUM_MEMORY - 50) + "(0)",
+    }));
+    const auto info = machine.run();
+    EXPECT_EQ(mixal::StopReason::ERROR, info.reason);
+    EXPECT_EQ(3000, info.line);
+    machine.loadCodes(std::vector<std::string>({
+        "     ORIG 3000",
+        "     IN   " + std::to_string(mixal::Computer::NUM_MEMORY - 100) + "(0)",
+        "     HLT",
+    }));
+    EXPECT_EQ(mixal::StopReason::HALT, machine.run().reason);
+}
+
+TEST(TestMachineIO, test_tape_grows_beyond_storage) {
+    mixal::IODeviceTape tape(100);
+    mixal::ComputerWord memory[mixal::Computer::NUM_MEMORY];
+    memory[0].set(7);
+    tape.control(2);
+    tape.write(memory, 0);
+    while (!tape.ready(1000)) {}
+    EXPECT_EQ(7, tape.storage().get(200).value());
+    EXPECT_EQ(300, tape.storage().size());
+}
+
+TEST(TestMachineIO, test_devices_recycled_on_reset) {
+    mixal::Computer machine;
+    machine.loadCodes({
+        "     ORIG 3000",
+        "     OUT  1000(18)",
+        "     HLT",
+    });
+    machine.memory[1000].set("HELLO");
+    machine.executeUntilHalt();
+    const auto printer = machine.getDevice(18);
+    machine.reset();
+    EXPECT_EQ(nullptr, machine.devices[18]);
+    EXPECT_EQ(printer, machine.getDevice(18));
+    const auto& storage = dynamic_cast<mixal::IODeviceLinePrinter*>(printer)->storage();
+    EXPECT_EQ(0, storage.numAllocatedPages());
+    EXPECT_EQ(0, storage.get(0).value());
+}
+
+TEST(TestMachineIO, test_mapped_word_encoding) {
+    const mixal::ComputerWord word('-', 1, 2, 3, 4, 63);
+    EXPECT_EQ(word, mixal::MappedStorage::decode(mixal::MappedStorage::encode(word)));
+    EXPECT_EQ(0u, mixal::MappedStorage::encode(mixal::ComputerWord()));
+}
+
+TEST(TestMachineIO, test_mapped_tape_persists) {
+    const auto path = (std::filesystem::temp_directory_path() / "mixal_test_mapped_tape.bin").string();
+    std::filesystem::remove(path);
+    {
+        mixal::Computer machine;
+        machine.loadCodes({
+            "     ORIG 3000",
+            "     OUT  1000(2)",
+            "     HLT",
+        });
+        machine.mapDeviceFile(2, path);
+        machine.memory[1000].set(1000);
+        machine.memory[1099].set(-1099);
+        machine.executeUntilHalt();
+    }
+    EXPECT_EQ(100u * mixal::MappedStorage::WORD_BYTES, std::filesystem::file_size(path));
+    mixal::Computer machine;
+    machine.loadCodes({
+        "     ORIG 3000",
+        "     IN   2000(2)",
+        "     HLT",
+    });
+    machine.mapDeviceFile(2, path);
+    machine.executeUntilHalt();
+    EXPECT_EQ(1000, machine.memory[2000].value());
+    EXPECT_EQ(-1099, machine.memory[2099].value());
+    const auto tape = dynamic_cast<mixal::IODeviceStorage*>(machine.getDevice(2));
+    EXPECT_TRUE(tape->mapped());
+    EXPECT_EQ(1000, tape->loadWord(0).value());
+    EXPECT_THROW(tape->wordAt(0), std::logic_error);
+    machine.unmapDeviceFile(2);
+    EXPECT_FALSE(tape->mapped());
+    EXPECT_THROW(machine.mapDeviceFile(18, path), mixal::RuntimeError);
+    std::filesystem::remove(path);
+}
+
+TEST(TestMachineIO, test_streaming_card_reader_and_printer) {
+    mixal::Computer machine;
+    machine.loadCodes({
+        "     ORIG 3000",
+        "LOOP IN   100(16)",
+        "     JBUS *(16)",
+        "     LDA  100",
+        "     JAZ  DONE",
+        "     OUT  100(18)",
+        "     JMP  LOOP",
+        "DONE HLT",
+    });
+    std::istringstream deck("HELLO WORLD\nPRIME NUMBERS\r\n\n");
+    machine.setDeviceSource(16, std::make_shared<mixal::TextBlockSource>(deck));
+    std::vector<std::string> lines;
+    machine.setDeviceSink(18, std::make_shared<mixal::TextBlockSink>([&](const std::string& line) {
+        lines.push_back(line);
+    }));
+    machine.executeUntilHalt();
+    ASSERT_EQ(2u, lines.size());
+    EXPECT_EQ("HELLO WORLD", lines[0]);
+    EXPECT_EQ("PRIME NUMBERS", lines[1]);
+    EXPECT_TRUE(machine.getDevice(16)->exhausted());
+}
+
+TEST(TestMachineIO, test_streaming_source_waits_for_input) {
+    mixal::Computer machine;
+    machine.loadCodes({
+        "     ORIG 3000",
+        "LOOP IN   100(16)",
+        "     JMP  LOOP",
+    });
+    std::istringstream deck("ONE\nTWO\n");
+    machine.setDeviceSource(16, std::make_shared<mixal::TextBlockSource>(deck));
+    const auto info = machine.run();
+    EXPECT_EQ(mixal::StopReason::WAITING_FOR_INPUT, info.reason);
+    EXPECT_EQ(3000, info.line);
+    EXPECT_THROW(machine.setDeviceSource(18, nullptr), mixal::RuntimeError);
+    EXPECT_THROW(machine.setDeviceSink(16, nullptr), mixal::RuntimeError);
+}
+
+TEST(TestMachineIO, test_text_block_conversion) {
+    mixal::ComputerWord words[2];
+    mixal::TextBlockSource::convert("AB~CDEFGHIJKL", words, 2);
+    EXPECT_EQ("AB CD", words[0].getCharacters());
+    EXPECT_EQ("EFGHI", words[1].getCharacters());
+    EXPECT_EQ("AB CDEFGHI", mixal::TextBlockSink::convert(words, 2));
+}
+
+TEST(TestMachineIO, test_async_file_source_and_sink) {
+    const auto inputPath = (std::filesystem::temp_directory_path() / "mixal_test_async_input.txt").string();
+    const auto outputPath = (std::filesystem::temp_directory_path() / "mixal_test_async_output.txt").string();
+    {
+        std::ofstream input(inputPath);
+        for (int i = 0; i < 500; ++i) {
+            input << "CARD " << i << '\n';
+        }
+        input << '\n';
+    }
+    mixal::Computer machine;
+    machine.loadCodes({
+        "     ORIG 3000",
+        "LOOP IN   100(16)",
+        "     JBUS *(16)",
+        "     LDA  100",
+        "     JAZ  DONE",
+        "     OUT  100(18)",
+        "     JMP  LOOP",
+        "DONE HLT",
+    });
+    auto source = std::make_shared<mixal::TextBlockSource>(std::make_unique<std::ifstream>(inputPath));
+    machine.setDeviceSource(16, std::make_shared<mixal::AsyncBlockSource>(source, 8));
+    auto sink = std::make_shared<mixal::TextBlockSink>(std::make_unique<std::ofstream>(outputPath));
+    machine.setDeviceSink(18, std::make_shared<mixal::AsyncBlockSink>(sink));
+    EXPECT_EQ(mixal::StopReason::HALT, machine.run().reason);
+    std::ifstream output(outputPath);
+    std::string line;
+    int count = 0;
+    while (std::getline(output, line)) {
+        EXPECT_EQ("CARD " + std::to_string(count), line);
+        ++count;
+    }
+    EXPECT_EQ(500, count);
+    machine.reset();
+    std::filesystem::remove(inputPath);
+    std::filesystem::remove(outputPath);
+}
+
+TEST(TestMachineIO, test_async_source_error) {
+    class FailingSource final : public mixal::BlockSource {
+     public:
+        bool next(mixal::ComputerWord*, int32_t) override { throw std::runtime_error("broken"); }
+    };
+    mixal::AsyncBlockSource source(std::make_shared<FailingSource>());
+    mixal::ComputerWord words[16];
+    EXPECT_THROW(source.next(words, 16), std::runtime_error);
+    EXPECT_FALSE(source.next(words, 16));
+    EXPECT_THROW(source.next(words, 14), std::logic_error);
+}
+
+TEST(TestMachineIO, test_printer_page) {
+    mixal::IODeviceLinePrinter printer(4096, 2);
+    mixal::ComputerWord memory[mixal::Computer::NUM_MEMORY];
+    mixal::textToWords("FIRST LINE", memory, 24);
+    printer.write(memory, 0);
+    while (!printer.ready(1000)) {}
+    const auto page = printer.page(0);
+    EXPECT_EQ(2u * 81, page.size());
+    EXPECT_EQ(printer.line(0, 0) + "\n" + printer.line(0, 1) + "\n", page);
+    EXPECT_EQ("FIRST LINE", page.substr(0, 10));
+}
+
+TEST(TestMachineIO, test_fast_forward_jbus) {
+    mixal::Computer machine;
+    machine.setCountersEnabled(true);
+    machine.loadCodes({
+        "     ORIG 3000",
+        "     OUT  1000(18)",
+        "     JBUS *(18)",
+        "     HLT",
+    });
+    EXPECT_TRUE(machine.idleFastForward());
+    machine.executeUntilHalt();
+    const auto counters = machine.performanceCounters();
+    const auto polls = counters.instructionCount(mixal::Instructions::JBUS, 18);
+    EXPECT_GE(polls, 1);
+    EXPECT_EQ(1 + polls, machine.elapsed());
+    EXPECT_EQ(polls - 1, counters.deviceWaitCycles[18]);
+    EXPECT_EQ(1 + polls, machine.steps());
+    EXPECT_EQ(polls - 1, counters.jumpsTaken);
+    EXPECT_EQ(1, counters.jumpsNotTaken);
+    EXPECT_FALSE(machine.getDevice(18)->busy());
+}
+
+TEST(TestMachineIO, test_fast_forward_jred_loop) {
+    mixal::Computer machine;
+    machine.setCountersEnabled(true);
+    machine.loadCodes({
+        "     ORIG 3000",
+        "     OUT  1000(18)",
+        "LOOP JRED DONE(18)",
+        "     JMP  LOOP",
+        "DONE HLT",
+    });
+    machine.executeUntilHalt();
+    const auto counters = machine.performanceCounters();
+    const auto polls = counters.instructionCount(mixal::Instructions::JRED, 18);
+    EXPECT_EQ(polls - 1, counters.instructionCount(mixal::Instructions::JMP, 0));
+    EXPECT_EQ(1 + polls + (polls - 1), machine.elapsed());
+    EXPECT_EQ(polls - 1, counters.deviceWaitCycles[18]);
+    EXPECT_EQ(polls, counters.jumpsTaken);
+    EXPECT_EQ(3004, machine.line());
+}
+
+TEST(TestMachineIO, test_fast_forward_distribution) {
+    const std::vector<std::string> codes = {
+        "     ORIG 3000",
+        "     OUT  1000(18)",
+        "     JBUS *(18)",
+        "     HLT",
+    };
+    auto meanElapsed = [&](const bool fastForward) {
+        srand(42);
+        int64_t total = 0;
+        constexpr int NUM_RUNS = 2000;
+        for (int i = 0; i < NUM_RUNS; ++i) {
+            mixal::Computer machine;
+            machine.setIdleFastForward(fastForward);
+            machine.loadCodes(codes);
+            machine.executeUntilHalt();
+            total += machine.elapsed();
+        }
+        return static_cast<double>(total) / NUM_RUNS;
+    };
+    const double slow = meanElapsed(false);
+    const double fast = meanElapsed(true);
+    EXPECT_NEAR(slow, fast, slow * 0.1);
+}
+
+TEST(TestMachineIO, test_polling_wait_cycles) {
+    for (const bool fastForward : {false, true}) {
+        mixal::Computer machine;
+        machine.setIdleFastForward(fastForward);
+        machine.loadCodes({
+            "     ORIG 3000",
+            "     OUT  1000(18)",
+            "     JBUS *(18)",
+            "     HLT",
+        });
+        machine.executeUntilHalt();
+        const auto counters = machine.performanceCounters();
+        EXPECT_EQ(machine.elapsed() - 2, counters.deviceWaitCycles[18]);
+        EXPECT_EQ(counters.steps - 2, counters.jumpsTaken);
+        EXPECT_EQ(1, counters.jumpsNotTaken);
+    }
+}
+
+TEST(TestMachineIO, test_fast_forward_respects_budget) {
+    for (const bool fastForward : {false, true}) {
+        mixal::Computer machine;
+        machine.setIdleFastForward(fastForward);
+        machine.registerDevice(0, []() {
+            return std::make_unique<mixal::IODeviceCallback>(
+                4, nullptr, [](std::span<const mixal::ComputerWord>) {}, nullptr, 1e-9);
+        });
+        machine.loadCodes({
+            "     ORIG 3000",
+            "     OUT  2000(0)",
+            "     JBUS *(0)",
+            "     HLT",
+        });
+        auto info = machine.run(-1, 20);
+        EXPECT_EQ(mixal::StopReason::BUDGET_EXHAUSTED, info.reason);
+        EXPECT_EQ(20, machine.elapsed());
+        EXPECT_EQ(3001, info.line);
+        info = machine.run(5);
+        EXPECT_EQ(mixal::StopReason::BUDGET_EXHAUSTED, info.reason);
+        EXPECT_EQ(25, machine.elapsed());
+        EXPECT_EQ(25, machine.steps());
+        mixal::ResourceLimits limits;
+        limits.elapsed = 40;
+        machine.setResourceLimits(limits);
+        info = machine.run();
+        EXPECT_EQ(mixal::StopReason::RESOURCE_LIMIT, info.reason);
+        EXPECT_EQ(40, machine.elapsed());
+        EXPECT_EQ(39, machine.performanceCounters().deviceWaitCycles[0]);
+    }
+}
+
+TEST(TestMachineIO, test_fast_forward_jred_respects_budget) {
+    for (const bool fastForward : {false, true}) {
+        mixal::Computer machine;
+        machine.setIdleFastForward(fastForward);
+        machine.registerDevice(0, []() {
+            return std::make_unique<mixal::IODeviceCallback>(
+                4, nullptr, [](std::span<const mixal::ComputerWord>) {}, nullptr, 1e-9);
+        });
+        machine.loadCodes({
+            "     ORIG 3000",
+            "     OUT  2000(0)",
+            "LOOP JRED DONE(0)",
+            "     JMP  LOOP",
+            "DONE HLT",
+        });
+        auto info = machine.run(-1, 20);
+        EXPECT_EQ(mixal::StopReason::BUDGET_EXHAUSTED, info.reason);
+        EXPECT_EQ(20, machine.elapsed());
+        EXPECT_EQ(3002, info.line);
+        info = machine.run(6);
+        EXPECT_EQ(mixal::StopReason::BUDGET_EXHAUSTED, info.reason);
+        EXPECT_EQ(26, machine.elapsed());
+        EXPECT_EQ(3002, info.line);
+    }
+}
+
+TEST(TestMachineIO, test_register_callback_device) {
+    mixal::Computer machine;
+    int generated = 0;
+    std::vector<int32_t> captured;
+    std::vector<int32_t> controls;
+    machine.registerDevice(5, [&]() {
+        return std::make_unique<mixal::IODeviceCallback>(
+            4,
+            [&](std::span<mixal::ComputerWord> block) {
+                if (generated >= 2) {
+                    return false;
+                }
+                for (auto& word : block) {
+                    word.set(++generated * 100);
+                }
+                return true;
+            },
+            [&](std::span<const mixal::ComputerWord> block) {
+                for (const auto& word : block) {
+                    captured.push_back(word.value());
+                }
+            },
+            [&](const int32_t operation) { controls.push_back(operation); });
+    });
+    EXPECT_TRUE(machine.hasRegisteredDevice(5));
+    machine.loadCodes({
+        "     ORIG 3000",
+        "     IN   1000(5)",
+        "     JBUS *(5)",
+        "     OUT  1000(5)",
+        "     IOC  7(5)",
+        "     HLT",
+    });
+    machine.executeUntilHalt();
+    EXPECT_EQ(100, machine.memory[1000].value());
+    EXPECT_EQ(400, machine.memory[1003].value());
+    EXPECT_EQ(std::vector<int32_t>({100, 200, 300, 400}), captured);
+    EXPECT_EQ(std::vector<int32_t>({7}), controls);
+    EXPECT_EQ(mixal::IODeviceType::CUSTOM, machine.getDevice(5)->type());
+    EXPECT_EQ(4, machine.getDevice(5)->blockSize());
+
+    generated = 2;
+    machine.loadCodes({
+        "     ORIG 3000",
+        "     IN   1000(5)",
+        "     JBUS *(5)",
+        "     IN   1000(5)",
+        "     HLT",
+    });
+    machine.memory[1000].set(1);
+    const auto info = machine.run();
+    EXPECT_EQ(mixal::StopReason::WAITING_FOR_INPUT, info.reason);
+    EXPECT_EQ(3002, info.line);
+    EXPECT_EQ(0, machine.memory[1000].value());
+
+    machine.registerDevice(5, nullptr);
+    EXPECT_FALSE(machine.hasRegisteredDevice(5));
+    EXPECT_EQ(mixal::IODeviceType::TAPE, machine.getDevice(5)->type());
+    EXPECT_THROW(machine.registerDevice(21, nullptr), mixal::RuntimeError);
+}
+
+TEST(TestMachineIO, test_device_faults) {
+    mixal::Computer machine;
+    machine.loadCodes({
+        "     ORIG 3000",
+        "     OUT  1000(30)",
+        "     HLT",
+    });
+    auto info = machine.run();
+    EXPECT_EQ(mixal::StopReason::ERROR, info.reason);
+    EXPECT_EQ(mixal::FaultCode::INVALID_DEVICE, info.fault.code);
+    EXPECT_EQ(30, info.fault.operand);
+    EXPECT_EQ("Invalid device: 30", info.message);
+    EXPECT_EQ(3000, machine.line());
+
+    machine.registerDevice(5, []() -> std::unique_ptr<mixal::IODevice> { return nullptr; });
+    machine.loadCodes({
+        "     ORIG 3000",
+        "     IN   1000(5)",
+        "     HLT",
+    });
+    info = machine.run();
+    EXPECT_EQ(mixal::StopReason::ERROR, info.reason);
+    EXPECT_EQ(mixal::FaultCode::NULL_DEVICE, info.fault.code);
+    EXPECT_EQ("The device factory returns null: 5", info.message);
+    EXPECT_THROW(machine.executeUntilHalt(), mixal::RuntimeError);
+    EXPECT_THROW(machine.getDevice(5), mixal::RuntimeError);
+}
@@ -36,14 +36,14 @@ TEST(TestMachineJump, test_jov_on) {
     mixal::Computer machine;
     machine.loadCodes({
         "     ORIG 3000",
-        "     LDA  =1073741814=",
-        "     ADD  =1073741814=",
+        "     LDA  =" + std::to_string(mixal::WordFormat::power(5) - 10) + "=",
+        "     ADD  =" + std::to_string(mixal::WordFormat::power(5) - 10) + "=",
         "     JOV  EXIT",
         "     ENTA 35",
         "EXIT JMP  EXIT",
     });
     machine.executeUntilSelfLoop();
-    EXPECT_EQ(1073741804, machine.rA.value());
+    EXPECT_EQ(mixal::WordFormat::power(5) - 20, machine.rA.value());
     EXPECT_EQ(3005, machine.rJ.value());
 }
 
@@ -51,7 +51,7 @@ TEST(TestMachineJump, test_jov_off) {
     mixal::Computer machine;
     machine.loadCodes({
         "     ORIG 3000",
-        "     LDA  =1073741814=",
+        "     LDA  =" + std::to_string(mixal::WordFormat::power(5) - 10) + "=",
         "     ADD  =1=",
         "     JOV  EXIT",
         "     ENTA 35",
@@ -66,8 +66,8 @@ TEST(TestMachineJump, test_jnov_off) {
     mixal::Computer machine;
     machine.loadCodes({
         "     ORIG 3000",
-        "     LDA  =1073741814=",
-        "     ADD  =1073741814=",
+        "     LDA  =" + std::to_string(mixal::WordFormat::power(5) - 10) + "=",
+        "     ADD  =" + std::to_string(mixal::WordFormat::power(5) - 10) + "=",
         "     JNOV EXIT",
         "     ENTA 35",
         "EXIT JMP  EXIT",
@@ -81,14 +81,14 @@ TEST(TestMachineJump, test_jnov_on) {
     mixal::Computer machine;
     machine.loadCodes({
         "     ORIG 3000",
-        "     LDA  =1073741814=",
+        "     LDA  =" + std::to_string(mixal::WordFormat::power(5) - 10) + "=",
         "     ADD  =1=",
         "     JNOV EXIT",
         "     ENTA 35",
         "EXIT JMP  EXIT",
     });
     machine.executeUntilSelfLoop();
-    EXPECT_EQ(1073741815, machine.rA.value());
+    EXPECT_EQ(mixal::WordFormat::power(5) - 9, machine.rA.value());
     EXPECT_EQ(3005, machine.rJ.value());
 }
 
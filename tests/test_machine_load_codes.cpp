@@ -144,7 +144,7 @@ TEST(TestMachineLoadCodes, test_load_literal_constant) {
 TEST(TestMachineLoadCodes, test_load_constant_out_of_range) {
     mixal::Computer machine;
     std::vector<std::string> codes = {
-        " ORIG 4000",
+        " ORIG " + std::to_string(mixal::Computer::NUM_MEMORY),
         " LDA  =10-23=,0+0(2+3)",
     };
     EXPECT_THROW(machine.loadCodes(codes, false), mixal::RuntimeError);
@@ -153,7 +153,7 @@ TEST(TestMachineLoadCodes, test_load_constant_out_of_range) {
 TEST(TestMachineLoadCodes, test_load_out_of_range) {
     mixal::Computer machine;
     std::vector<std::string> codes = {
-        " ORIG 4000",
+        " ORIG " + std::to_string(mixal::Computer::NUM_MEMORY),
         " LDA  23",
     };
     EXPECT_THROW(machine.loadCodes(codes, false), mixal::RuntimeError);
@@ -0,0 +1,121 @@
+#include <iostream>
+#include <gtest/gtest.h>
+#include "machine.h"
+
+TEST(TestMachineLoop, test_two_instructions_loop) {
+    mixal::Computer machine;
+    machine.setLoopDetection(true);
+    machine.loadCodes({
+        "     ORIG 3000",
+        "LOOP ENTA 5",
+        "     JMP  LOOP",
+    });
+    const auto info = machine.run();
+    EXPECT_EQ(mixal::StopReason::NON_TERMINATING_LOOP, info.reason);
+    EXPECT_EQ(3001, info.line);
+    EXPECT_EQ(4, machine.elapsed());
+}
+
+TEST(TestMachineLoop, test_terminating_loop) {
+    mixal::Computer machine;
+    machine.setLoopDetection(true);
+    machine.loadCodes({
+        "     ORIG 3000",
+        "     ENT1 1000",
+        "LOOP LDA  2000",
+        "     INCA 1",
+        "     STA  2000",
+        "     DEC1 1",
+        "     J1P  LOOP",
+        "     HLT",
+    });
+    EXPECT_EQ(mixal::StopReason::HALT, machine.run().reason);
+    EXPECT_EQ(1000, machine.memory[2000].value());
+}
+
+TEST(TestMachineLoop, test_memory_rotation) {
+    mixal::Computer machine;
+    machine.setLoopDetection(true);
+    machine.loadCodes({
+        "     ORIG 3000",
+        "LOOP ENT1 2000",
+        "     MOVE 2001(3)",
+        "     ENT1 2003",
+        "     MOVE 2000(1)",
+        "     JMP  LOOP",
+    });
+    machine.memory[2001].set(1);
+    machine.memory[2002].set(2);
+    machine.memory[2003].set(3);
+    const auto info = machine.run();
+    EXPECT_EQ(mixal::StopReason::NON_TERMINATING_LOOP, info.reason);
+    EXPECT_EQ(4 * 13, machine.elapsed());
+    EXPECT_EQ(2, machine.memory[2001].value());
+    EXPECT_EQ(3, machine.memory[2002].value());
+    EXPECT_EQ(1, machine.memory[2003].value());
+}
+
+TEST(TestMachineLoop, test_io_loop_not_reported) {
+    mixal::Computer machine;
+    machine.setLoopDetection(true);
+    machine.loadCodes({
+        "     ORIG 3000",
+        "LOOP OUT  1000(18)",
+        "     JMP  LOOP",
+    });
+    mixal::ResourceLimits limits;
+    limits.printedLines = 20;
+    machine.setResourceLimits(limits);
+    EXPECT_EQ(mixal::StopReason::RESOURCE_LIMIT, machine.run().reason);
+}
+
+TEST(TestMachineLoop, test_disabled) {
+    mixal::Computer machine;
+    machine.loadCodes({
+        "     ORIG 3000",
+        "LOOP ENTA 5",
+        "     JMP  LOOP",
+    });
+    EXPECT_FALSE(machine.loopDetection());
+    EXPECT_EQ(mixal::StopReason::BUDGET_EXHAUSTED, machine.run(1000).reason);
+}
+
+TEST(TestMachineLoop, test_long_cycle) {
+    mixal::Computer machine;
+    machine.setLoopDetection(true);
+    machine.loadCodes({
+        "      ORIG 3000",
+        "START ENT1 0",
+        "LOOP  INC1 1",
+        "      CMP1 LIMIT",
+        "      JL   LOOP",
+        "      JMP  START",
+        "LIMIT CON  1000",
+    });
+    EXPECT_EQ(mixal::StopReason::NON_TERMINATING_LOOP, machine.run().reason);
+    EXPECT_GT(machine.elapsed(), 1000 * 5);
+}
+
+TEST(TestMachineLoop, test_execute_until_self_loop) {
+    mixal::Computer machine;
+    machine.setLoopDetection(true);
+    machine.loadCodes({
+        "      ORIG 3000",
+        "START ENT1 0",
+        "LOOP  INC1 1",
+        "      CMP1 LIMIT",
+        "      JL   LOOP",
+        "      JMP  START",
+        "LIMIT CON  1000",
+    });
+    machine.executeUntilSelfLoop();
+    EXPECT_GT(machine.elapsed(), 1000 * 5);
+    machine.reset();
+    machine.loadCodes({
+        "     ORIG 3000",
+        "LOOP ENTA 5",
+        "     JMP  LOOP",
+    });
+    machine.executeUntilHaltOrSelfLoop();
+    EXPECT_EQ(4, machine.elapsed());
+}
@@ -1,4 +1,5 @@
 #include <iostream>
+#include <tuple>
 #include <gtest/gtest.h>
 #include "machine.h"
 #include "parser.h"
@@ -279,6 +280,29 @@ TEST(TestMachineMISC, test_src_9) {
     EXPECT_EQ(mixal::ComputerWord(true, 7, 8, 9, 10, 1), machine.rX);
 }
 
+TEST(TestMachineMISC, test_shift_ax_all_amounts) {
+    const uint8_t bytes[] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 63};
+    for (int shift = 0; shift < 10; ++shift) {
+        for (const auto& [name, left, circular] : {std::tuple{"SLAX", true, false}, std::tuple{"SRAX", false, false},
+                                                   std::tuple{"SLC", true, true}, std::tuple{"SRC", false, true}}) {
+            mixal::Computer machine;
+            machine.rA.set(true, 1, 2, 3, 4, 5);
+            machine.rX.set(false, 6, 7, 8, 9, 63);
+            auto result = mixal::Parser::parseLine(std::string(name) + " " + std::to_string(shift), "", false);
+            machine.executeSingle(&result);
+            uint8_t expected[10];
+            for (int i = 0; i < 10; ++i) {
+                const int source = left ? i + shift : i - shift;
+                expected[i] = circular ? bytes[(source + 10) % 10] : (0 <= source && source < 10 ? bytes[source] : 0);
+            }
+            EXPECT_EQ(mixal::ComputerWord(true, expected[0], expected[1], expected[2], expected[3], expected[4]),
+                      machine.rA) << name << " " << shift;
+            EXPECT_EQ(mixal::ComputerWord(false, expected[5], expected[6], expected[7], expected[8], expected[9]),
+                      machine.rX) << name << " " << shift;
+        }
+    }
+}
+
 TEST(TestMachineMISC, test_move_safe) {
     mixal::Computer machine;
     machine.rI1.set(999);
@@ -324,6 +348,51 @@ TEST(TestMachineMISC, test_move_stacked) {
     EXPECT_EQ(123, machine.memory[1002].value());
 }
 
+TEST(TestMachineMISC, test_move_overlapping_chunks) {
+    mixal::Computer machine;
+    for (int i = 0; i < 10; ++i) {
+        machine.memory[1000 + i].set(i + 1);
+    }
+    machine.rI1.set(1003);
+    auto result = mixal::Parser::parseLine("MOVE 1000(10)", "", false);
+    machine.executeSingle(&result);
+    for (int i = 0; i < 13; ++i) {
+        EXPECT_EQ(i % 3 + 1, machine.memory[1000 + i].value());
+    }
+    EXPECT_EQ(1013, machine.rI1.value());
+
+    for (int i = 0; i < 10; ++i) {
+        machine.memory[2000 + i].set(i + 1);
+    }
+    machine.rI1.set(1998);
+    result = mixal::Parser::parseLine("MOVE 2000(10)", "", false);
+    machine.executeSingle(&result);
+    for (int i = 0; i < 10; ++i) {
+        EXPECT_EQ(i + 1, machine.memory[1998 + i].value());
+    }
+    EXPECT_EQ(9, machine.memory[2008].value());
+}
+
+TEST(TestMachineMISC, test_move_partially_out_of_range) {
+    mixal::Computer machine;
+    machine.memory[0].set(1);
+    machine.memory[1].set(2);
+    machine.memory[2].set(3);
+    constexpr int last = mixal::Computer::NUM_MEMORY - 1;
+    machine.rI1.set(last - 2);
+    auto result = mixal::Parser::parseLine("MOVE 0(5)", "", false);
+    machine.executeSingle(&result);
+    EXPECT_EQ(1, machine.memory[last - 2].value());
+    EXPECT_EQ(2, machine.memory[last - 1].value());
+    EXPECT_EQ(3, machine.memory[last].value());
+    EXPECT_EQ((last + 3) % mixal::WordFormat::power(2), machine.rI1.value());
+    machine.rI1.set(-2);
+    result = mixal::Parser::parseLine("MOVE " + std::to_string(last - 2) + "(4)", "", false);
+    machine.executeSingle(&result);
+    EXPECT_EQ(3, machine.memory[0].value());
+    EXPECT_EQ(2, machine.memory[1].value());
+}
+
 TEST(TestMachineMISC, test_move_out_of_range) {
     mixal::Computer machine;
     machine.rI1.set(4000);
@@ -0,0 +1,159 @@
+#include <chrono>
+#include <iostream>
+#include <gtest/gtest.h>
+#include "machine.h"
+
+TEST(TestMachineRun, test_step_budget_resume) {
+    const std::vector<std::string> codes = {
+        "     ORIG 3000",
+        "     ENT1 100",
+        "LOOP INCA 2",
+        "     DEC1 1",
+        "     J1P  LOOP",
+        "     HLT",
+    };
+    mixal::Computer expected;
+    expected.loadCodes(codes);
+    expected.executeUntilHalt();
+
+    mixal::Computer machine;
+    machine.loadCodes(codes);
+    auto info = machine.run(0);
+    EXPECT_EQ(mixal::StopReason::BUDGET_EXHAUSTED, info.reason);
+    EXPECT_EQ(3000, info.line);
+    int numRuns = 0;
+    do {
+        info = machine.run(7);
+        ++numRuns;
+    } while (info.reason == mixal::StopReason::BUDGET_EXHAUSTED);
+    EXPECT_EQ(mixal::StopReason::HALT, info.reason);
+    EXPECT_EQ(44, numRuns);
+    EXPECT_EQ(expected.rA.value(), machine.rA.value());
+    EXPECT_EQ(expected.line(), machine.line());
+    EXPECT_EQ(expected.elapsed(), machine.elapsed());
+}
+
+TEST(TestMachineRun, test_elapsed_budget) {
+    mixal::Computer machine;
+    machine.loadCodes({
+        "     ORIG 3000",
+        "LOOP LDA  1000",
+        "     JMP  LOOP",
+    });
+    machine.setLoopDetection(false);
+    const auto info = machine.run(-1, 100);
+    EXPECT_EQ(mixal::StopReason::BUDGET_EXHAUSTED, info.reason);
+    EXPECT_EQ(101, machine.elapsed());
+    EXPECT_EQ(3001, machine.line());
+}
+
+TEST(TestMachineRun, test_waiting_for_input) {
+    mixal::Computer machine;
+    machine.loadCodes({
+        "     ORIG 3000",
+        "LOOP IN   100(16)",
+        "     JBUS *(16)",
+        "     JMP  LOOP",
+    });
+    const auto info = machine.run();
+    EXPECT_EQ(mixal::StopReason::WAITING_FOR_INPUT, info.reason);
+    EXPECT_EQ(3000, info.line);
+    EXPECT_TRUE(machine.getDevice(16)->exhausted());
+    EXPECT_EQ(mixal::StopReason::WAITING_FOR_INPUT, machine.run().reason);
+}
+
+TEST(TestMachineRun, test_error) {
+    mixal::Computer machine;
+    const auto info = machine.run(-1, -1);
+    EXPECT_EQ(mixal::StopReason::ERROR, info.reason);
+}
+
+TEST(TestMachineRun, test_fault) {
+    mixal::Computer machine;
+    machine.loadCodes({
+        "     ORIG 3000",
+        "     ENTX 7",
+        "     DIV  1000",
+        "     HLT",
+    });
+    auto info = machine.run();
+    EXPECT_EQ(mixal::StopReason::ERROR, info.reason);
+    EXPECT_EQ(3001, info.line);
+    EXPECT_EQ("Divisor cannot be 0", info.message);
+    EXPECT_EQ(mixal::FaultCode::DIVISION_BY_ZERO, info.fault.code);
+    EXPECT_EQ(3001, info.fault.line);
+    EXPECT_EQ(machine.memory[3001], info.fault.instruction);
+    EXPECT_EQ(3001, machine.line());
+    EXPECT_EQ(1, machine.elapsed());
+
+    machine.memory[1000].set(1);
+    info = machine.run();
+    EXPECT_EQ(mixal::StopReason::HALT, info.reason);
+    EXPECT_EQ(mixal::FaultCode::NONE, info.fault.code);
+    EXPECT_EQ(7, machine.rA.value());
+}
+
+TEST(TestMachineRun, test_fault_message) {
+    mixal::Computer machine;
+    machine.loadCodes({
+        "     ORIG 3000",
+        "     LDA  3999",
+        "     HLT",
+    });
+    constexpr int last = mixal::Computer::NUM_MEMORY - 1;
+    machine.memory[3000].set(false, last, 7, 5, 8);  // LDA last,7
+    auto info = machine.run();
+    EXPECT_EQ(mixal::FaultCode::INVALID_INDEX, info.fault.code);
+    EXPECT_EQ(7, info.fault.operand);
+    EXPECT_EQ("Invalid offset for index register: 7", info.message);
+    machine.memory[3000].set(false, last, 1, 5, 8);  // LDA last,1(0:5)
+    machine.rI1.set(1);
+    info = machine.run();
+    EXPECT_EQ(mixal::FaultCode::INVALID_ADDRESS, info.fault.code);
+    EXPECT_EQ(last + 1, info.fault.operand);
+    EXPECT_EQ("Invalid address in instruction '" + machine.memory[3000].getBytesString() + "': " +
+              std::to_string(last + 1), info.message);
+    machine.memory[3000].set(false, 0, 0, 41, 8);  // LDA 0(5:1)
+    try {
+        machine.executeSingle();
+        FAIL();
+    } catch (const mixal::RuntimeError& error) {
+        EXPECT_EQ(3000, error.line());
+        EXPECT_EQ(std::string("Invalid field value: (5:1)"), error.what());
+    }
+    EXPECT_EQ(mixal::FaultCode::NONE, machine.run(0).fault.code);
+}
+
+TEST(TestMachineRun, test_run_as_fast_as_execute_until_halt) {
+    const std::vector<std::string> codes = {
+        "      ORIG 3000",
+        "START ENTA 0",
+        "LOOP  INCA 1",
+        "      CMPA LIMIT",
+        "      JL   LOOP",
+        "      HLT",
+        "LIMIT CON  1000000",
+        "      END  START",
+    };
+    auto measure = [&codes](const bool resumed) {
+        auto best = std::chrono::steady_clock::duration::max();
+        for (int trial = 0; trial < 3; ++trial) {
+            mixal::Computer machine;
+            machine.loadCodes(codes);
+            const auto start = std::chrono::steady_clock::now();
+            if (resumed) {
+                while (machine.run(10000).reason == mixal::StopReason::BUDGET_EXHAUSTED) {}
+            } else {
+                machine.executeUntilHalt();
+            }
+            best = std::min(best, std::chrono::steady_clock::now() - start);
+            EXPECT_EQ(1000000, machine.rA.value());
+        }
+        return best;
+    };
+    const auto interpreted = measure(false);
+    const auto resumed = measure(true);
+    std::cout << "executeUntilHalt: " << std::chrono::duration<double, std::milli>(interpreted).count()
+              << " ms, run: " << std::chrono::duration<double, std::milli>(resumed).count() << " ms" << std::endl;
+    EXPECT_LT(resumed, interpreted * 3 / 2);
+}
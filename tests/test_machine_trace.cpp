@@ -0,0 +1,107 @@
+#include <gtest/gtest.h>
+#include "machine.h"
+
+TEST(TestMachineTrace, test_ring_buffer) {
+    mixal::DeviceTrace trace(3);
+    EXPECT_TRUE(trace.enabled());
+    for (int i = 0; i < 5; ++i) {
+        trace.record({i, 0, 0, mixal::DeviceEventType::ISSUE, mixal::Instructions::OUT});
+    }
+    EXPECT_EQ(3u, trace.size());
+    EXPECT_EQ(2, trace.dropped());
+    const auto events = trace.events();
+    ASSERT_EQ(3u, events.size());
+    EXPECT_EQ(2, events[0].timestamp);
+    EXPECT_EQ(4, events[2].timestamp);
+    trace.clear();
+    EXPECT_EQ(0u, trace.size());
+    EXPECT_EQ(3u, trace.capacity());
+    EXPECT_FALSE(mixal::DeviceTrace().enabled());
+}
+
+TEST(TestMachineTrace, test_device_events) {
+    mixal::Computer machine;
+    machine.loadCodes({
+        "     ORIG 3000",
+        "     OUT  1000(0)",
+        "     JBUS *(0)",
+        "     OUT  1000(0)",
+        "     OUT  1000(0)",
+        "     HLT",
+    });
+    machine.executeUntilHalt();
+    EXPECT_EQ(0u, machine.deviceTrace().size());
+
+    machine.setDeviceTraceCapacity(64);
+    machine.loadCodes({
+        "     ORIG 3000",
+        "     OUT  1000(0)",
+        "     JBUS *(0)",
+        "     OUT  1000(0)",
+        "     OUT  1000(0)",
+        "     HLT",
+    });
+    EXPECT_EQ(0u, machine.deviceTrace().size());
+    const int64_t waitedBefore = machine.performanceCounters().deviceWaitCycles[0];
+    machine.executeUntilHalt();
+    const auto events = machine.deviceTrace().events();
+    int issues = 0, starts = 0, completions = 0;
+    int64_t waited = 0;
+    for (const auto& event : events) {
+        EXPECT_EQ(0, event.unit);
+        EXPECT_LE(event.timestamp + event.duration, machine.elapsed());
+        switch (event.type) {
+        case mixal::DeviceEventType::ISSUE: ++issues; break;
+        case mixal::DeviceEventType::START: ++starts; break;
+        case mixal::DeviceEventType::COMPLETE: ++completions; break;
+        case mixal::DeviceEventType::WAIT: waited += event.duration; break;
+        case mixal::DeviceEventType::POLL: waited += event.duration; break;
+        }
+    }
+    EXPECT_EQ(3, issues);
+    EXPECT_EQ(3, starts);
+    EXPECT_EQ(3, completions);
+    EXPECT_EQ(machine.performanceCounters().deviceWaitCycles[0] - waitedBefore, waited);
+    ASSERT_FALSE(events.empty());
+    EXPECT_EQ(mixal::DeviceEventType::ISSUE, events[0].type);
+    EXPECT_EQ(mixal::Instructions::OUT, events[0].operation);
+    for (size_t i = 1; i < events.size(); ++i) {
+        EXPECT_LE(events[i - 1].timestamp, events[i].timestamp);
+    }
+
+    const auto json = machine.deviceTrace().toChromeTrace();
+    EXPECT_EQ(0u, json.find(R"({"displayTimeUnit":"ns")"));
+    EXPECT_NE(std::string::npos, json.find(R"("args":{"name":"CPU"})"));
+    EXPECT_NE(std::string::npos, json.find(R"("args":{"name":"Unit 0"})"));
+    EXPECT_NE(std::string::npos, json.find(R"({"name":"OUT","ph":"X")"));
+    EXPECT_EQ(std::string::npos, json.find(R"("ph":"B")"));
+    EXPECT_EQ('}', json.back());
+
+    machine.reset();
+    EXPECT_EQ(0u, machine.deviceTrace().size());
+    EXPECT_EQ(64u, machine.deviceTrace().capacity());
+    machine.setDeviceTraceCapacity(0);
+    EXPECT_FALSE(machine.deviceTrace().enabled());
+}
+
+TEST(TestMachineTrace, test_poll_events) {
+    mixal::Computer machine;
+    machine.setDeviceTraceCapacity(64);
+    machine.loadCodes({
+        "     ORIG 3000",
+        "     OUT  1000(18)",
+        "     JBUS *(18)",
+        "     HLT",
+    });
+    machine.executeUntilHalt();
+    bool polled = false;
+    for (const auto& event : machine.deviceTrace().events()) {
+        if (event.type == mixal::DeviceEventType::POLL) {
+            polled = true;
+            EXPECT_EQ(18, event.unit);
+            EXPECT_GT(event.duration, 0);
+        }
+    }
+    EXPECT_TRUE(polled);
+    EXPECT_NE(std::string::npos, machine.deviceTrace().toChromeTrace().find(R"({"name":"poll","ph":"X")"));
+}
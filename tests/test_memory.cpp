@@ -60,3 +60,47 @@ TEST(TestMemory, test_set_characters_invalid_length) {
     mixal::ComputerWord word;
     EXPECT_THROW(word.set("A4+ -s"), std::runtime_error);
 }
+
+TEST(TestMemory, test_bulk_text_conversion) {
+    mixal::ComputerWord words[3];
+    words[2].set(-1);
+    EXPECT_EQ(9u, mixal::textToWords("HELLO´˚˝‚", words, 3));
+    EXPECT_EQ("HELLO", words[0].getCharacters());
+    EXPECT_EQ("´˚˝‚ ", words[1].getCharacters());
+    EXPECT_FALSE(words[2].negative);
+    EXPECT_EQ(0, words[2].value());
+    EXPECT_EQ("HELLO´˚˝‚      ", mixal::wordsToText(words, 3));
+    EXPECT_EQ(5u, mixal::textToWords("ab\xff\xe2\x80", words, 1));
+    EXPECT_EQ("     ", words[0].getCharacters());
+    EXPECT_EQ(9u, mixal::textToWords("TRUNCATED", words, 1));
+    EXPECT_EQ("TRUNC", words[0].getCharacters());
+}
+
+TEST(TestMemory, test_binary_byte_format) {
+    using F = mixal::ByteFormat<64>;
+    EXPECT_TRUE(F::BINARY);
+    EXPECT_EQ(6, F::BITS);
+    EXPECT_EQ(1073741824, F::power(5));
+    EXPECT_EQ(4095, F::combine(63, 63));
+    EXPECT_EQ(63, F::shiftRight(4095, 1));
+    EXPECT_EQ(63, F::lowBytes(4095, 1));
+    EXPECT_EQ(12, F::byteAt(12 * 64 * 64 + 34, 2));
+}
+
+TEST(TestMemory, test_decimal_byte_format) {
+    using F = mixal::ByteFormat<100>;
+    EXPECT_FALSE(F::BINARY);
+    EXPECT_EQ(10000000000LL, F::power(5));
+    EXPECT_EQ(9999, F::combine(99, 99));
+    EXPECT_EQ(12, F::shiftRight(int64_t{123456}, 2));
+    EXPECT_EQ(3456, F::lowBytes(int64_t{123456}, 2));
+    EXPECT_EQ(34, F::byteAt(int64_t{123456}, 1));
+    EXPECT_EQ(98, F::byteAt(int64_t{9876543210}, 4));
+}
+
+TEST(TestMemory, test_word_value_type) {
+    EXPECT_EQ(mixal::WordFormat::power(5) <= INT32_MAX, sizeof(mixal::WordValue) == sizeof(int32_t));
+    mixal::ComputerWord word;
+    word.set(static_cast<int64_t>(-(mixal::WordFormat::power(5) + 7)));
+    EXPECT_EQ(-7, word.value());
+}
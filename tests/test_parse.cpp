@@ -303,7 +303,7 @@ TEST(TestParse, test_parse_line_invalid_address_with_too_long) {
 }
 
 TEST(TestParse, test_parse_line_invalid_address_with_too_large) {
-    EXPECT_THROW(mixal::Parser::parseLine("LDA 5000", "", false), mixal::ParseError);
+    EXPECT_THROW(mixal::Parser::parseLine("LDA " + std::to_string(mixal::WordFormat::power(2)), "", false), mixal::ParseError);
 }
 
 TEST(TestParse, test_parse_line_invalid_address_with_invalid_character) {
@@ -0,0 +1,143 @@
+#include <stdexcept>
+#include <gtest/gtest.h>
+#include "timing.h"
+
+namespace {
+
+const std::vector<std::string> COUNTED = {
+    "      ORIG 1000",
+    "START ENT1 10",
+    "LOOP  ADD  =1=",
+    "      DEC1 1",
+    "      J1P  LOOP",
+    "      HLT",
+    "      END  START",
+};
+
+const std::vector<std::string> NESTED = {
+    "      ORIG 1000",
+    "START ENT2 3",
+    "OUTER JMP  SUB",
+    "      ENT1 4",
+    "INNER INCA 2",
+    "      DEC1 1",
+    "      J1P  INNER",
+    "      DEC2 1",
+    "      J2P  OUTER",
+    "      HLT",
+    "SUB   STJ  EXIT",
+    "      INCX 1",
+    "EXIT  JMP  *",
+    "      END  START",
+};
+
+}  // namespace
+
+TEST(TestTiming, test_counted_loop) {
+    mixal::Computer machine;
+    machine.loadCodes(COUNTED);
+    const auto analysis = mixal::analyzeTiming(machine, 1000);
+    ASSERT_EQ(3u, analysis.blocks.size());
+    EXPECT_EQ(1000, analysis.blocks[0].start);
+    EXPECT_EQ(1, analysis.blocks[0].cost);
+    EXPECT_EQ(1001, analysis.blocks[1].start);
+    EXPECT_EQ(3, analysis.blocks[1].length);
+    EXPECT_EQ(4, analysis.blocks[1].cost);
+    EXPECT_EQ(std::vector<int32_t>({1001, 1004}), analysis.blocks[1].successors);
+    EXPECT_EQ(0, analysis.blocks[1].loop);
+    EXPECT_EQ("10", analysis.blocks[1].count.toString());
+    EXPECT_EQ(0, analysis.blocks[2].cost);
+
+    ASSERT_EQ(1u, analysis.loops.size());
+    const auto& loop = analysis.loops[0];
+    EXPECT_EQ(1001, loop.header);
+    EXPECT_EQ(1003, loop.latch);
+    EXPECT_EQ(-1, loop.parent);
+    EXPECT_EQ(1, loop.counter);
+    EXPECT_EQ(10, loop.iterations);
+    EXPECT_EQ(std::vector<int32_t>({1001}), loop.blocks);
+    EXPECT_EQ("40", loop.cost.toString());
+
+    EXPECT_EQ("41", analysis.cost.toString());
+    machine.executeUntilHalt();
+    EXPECT_EQ(machine.elapsed(), analysis.estimate());
+}
+
+TEST(TestTiming, test_unknown_iterations) {
+    mixal::Computer machine;
+    auto codes = COUNTED;
+    codes[1] = "START LD1  N";
+    codes.insert(codes.end() - 1, "N     CON  7");
+    machine.loadCodes(codes);
+    const auto analysis = mixal::analyzeTiming(machine, 1000);
+    ASSERT_EQ(1u, analysis.loops.size());
+    EXPECT_EQ(-1, analysis.loops[0].iterations);
+    EXPECT_EQ("L1001", analysis.loops[0].symbol);
+    EXPECT_EQ("4*L1001", analysis.loops[0].cost.toString());
+    EXPECT_EQ("2 + 4*L1001", analysis.cost.toString());
+    EXPECT_THROW(static_cast<void>(analysis.estimate()), std::runtime_error);
+    machine.executeUntilHalt();
+    EXPECT_EQ(machine.elapsed(), analysis.estimate({{"L1001", 7}}));
+}
+
+TEST(TestTiming, test_nested_loops_and_subroutine) {
+    mixal::Computer machine;
+    machine.loadCodes(NESTED);
+    const auto analysis = mixal::analyzeTiming(machine, 1000);
+    ASSERT_EQ(2u, analysis.loops.size());
+    const auto& outer = analysis.loops[0];
+    const auto& inner = analysis.loops[1];
+    EXPECT_EQ(1001, outer.header);
+    EXPECT_EQ(2, outer.counter);
+    EXPECT_EQ(-1, outer.iterations);
+    EXPECT_EQ("20*L1001", outer.cost.toString());  // Including the 4 units of SUB
+    EXPECT_EQ(1003, inner.header);
+    EXPECT_EQ(0, inner.parent);
+    EXPECT_EQ(4, inner.iterations);
+    EXPECT_EQ("12", inner.cost.toString());
+
+    ASSERT_EQ(7u, analysis.blocks.size());
+    EXPECT_EQ(1009, analysis.blocks[6].start);
+    EXPECT_TRUE(analysis.blocks[6].successors.empty());
+    EXPECT_EQ(-1, analysis.blocks[6].loop);
+    EXPECT_EQ("L1001", analysis.blocks[6].count.toString());
+    EXPECT_EQ("4*L1001", analysis.blocks[3].count.toString());
+
+    EXPECT_EQ("1 + 20*L1001", analysis.cost.toString());
+    machine.executeUntilHalt();
+    EXPECT_EQ(machine.elapsed(), analysis.estimate({{"L1001", 3}}));
+}
+
+TEST(TestTiming, test_loop_calls_nested_subroutines) {
+    mixal::Computer machine;
+    machine.loadCodes({
+        "      ORIG 1000",
+        "START ENT1 3",
+        "LOOP  JMP  SUB1",
+        "      DEC1 1",
+        "      J1P  LOOP",
+        "      HLT",
+        "SUB1  STJ  EXIT1",
+        "      JMP  SUB2",
+        "      INCA 1",
+        "EXIT1 JMP  *",
+        "SUB2  STJ  EXIT2",
+        "      INCX 1",
+        "EXIT2 JMP  *",
+        "      END  START",
+    });
+    const auto analysis = mixal::analyzeTiming(machine, 1000);
+    ASSERT_EQ(1u, analysis.loops.size());
+    EXPECT_EQ("12*L1001", analysis.loops[0].cost.toString());  // 3 in the loop, 5 in SUB1 and 4 in SUB2
+    EXPECT_EQ("1 + 12*L1001", analysis.cost.toString());
+    machine.executeUntilHalt();
+    EXPECT_EQ(machine.elapsed(), analysis.estimate({{"L1001", 3}}));
+}
+
+TEST(TestTiming, test_invalid_entry) {
+    mixal::Computer machine;
+    const auto analysis = mixal::analyzeTiming(machine, -1);
+    EXPECT_TRUE(analysis.blocks.empty());
+    EXPECT_EQ("0", analysis.cost.toString());
+    EXPECT_EQ(0, analysis.estimate());
+}
@@ -0,0 +1,138 @@
+#include <cstdlib>
+#if defined(MIXAL_TRANSLATED_SQUARES)
+#include <dlfcn.h>
+#endif
+#include <gtest/gtest.h>
+#include "translator.h"
+#include "squares.h"
+
+#if !defined(MIXAL_TRANSLATED_SQUARES)
+/** The translation of `SQUARES` linked into the tests. */
+extern "C" int64_t mixal_translated_squares(mixal::Computer& machine);
+#endif
+
+namespace {
+
+/** The translation of `SQUARES`, loaded from the shared object built with the tests where it is supported. */
+mixal::TranslatedProgram translatedSquares() {
+#if defined(MIXAL_TRANSLATED_SQUARES)
+    static void* const handle = dlopen(MIXAL_TRANSLATED_SQUARES, RTLD_NOW | RTLD_LOCAL);
+    if (handle == nullptr) {
+        return nullptr;
+    }
+    return reinterpret_cast<mixal::TranslatedProgram>(dlsym(handle, "mixal_translated_squares"));
+#else
+    return mixal_translated_squares;
+#endif
+}
+
+void expectSameMachine(mixal::Computer& expected, mixal::Computer& actual) {
+    EXPECT_EQ(expected.rA, actual.rA);
+    EXPECT_EQ(expected.rX, actual.rX);
+    for (int i = 1; i <= mixal::Computer::NUM_INDEX_REGISTER; ++i) {
+        EXPECT_EQ(expected.rI(i).value(), actual.rI(i).value()) << i;
+    }
+    EXPECT_EQ(expected.rJ.value(), actual.rJ.value());
+    EXPECT_EQ(expected.overflow, actual.overflow);
+    EXPECT_EQ(expected.comparison, actual.comparison);
+    for (int i = 0; i < mixal::Computer::NUM_MEMORY; ++i) {
+        EXPECT_EQ(expected.memory[i], actual.memory[i]) << i;
+    }
+    EXPECT_EQ(expected.line(), actual.line());
+    EXPECT_EQ(expected.elapsed(), actual.elapsed());
+    EXPECT_EQ(expected.steps(), actual.steps());
+}
+
+}  // namespace
+
+TEST(TestTranslator, test_same_as_interpreter) {
+    mixal::Computer interpreted;
+    interpreted.loadCodes(SQUARES);
+    srand(1234);
+    interpreted.executeUntilHalt();
+
+    const auto program = translatedSquares();
+    ASSERT_NE(nullptr, program);
+    mixal::Computer translated;
+    translated.loadCodes(SQUARES);
+    srand(1234);
+    const int64_t native = program(translated);
+
+    expectSameMachine(interpreted, translated);
+    EXPECT_LT(0, native);
+    EXPECT_GT(translated.steps(), native);  // The STJ return slot is interpreted
+    EXPECT_EQ(361, translated.memory[1043].value());
+    EXPECT_EQ(mixal::ComputerWord("02470"), translated.rX);
+    EXPECT_EQ(translated.rX, translated.getDeviceWordAt(18, 1));
+}
+
+TEST(TestTranslator, test_modified_code_is_interpreted) {
+    mixal::Computer interpreted;
+    interpreted.loadCodes(SQUARES);
+    interpreted.memory[1000] = mixal::ComputerWord(false, 0, 1, 0, 2, 49);  // ENT1 1
+    interpreted.memory[1004] = mixal::ComputerWord(false, 0, 2, 0, 0, 49);  // INC1 2
+    srand(1234);
+    interpreted.executeUntilHalt();
+
+    const auto program = translatedSquares();
+    ASSERT_NE(nullptr, program);
+    mixal::Computer translated;
+    translated.loadCodes(SQUARES);
+    translated.memory[1000] = mixal::ComputerWord(false, 0, 1, 0, 2, 49);
+    translated.memory[1004] = mixal::ComputerWord(false, 0, 2, 0, 0, 49);
+    srand(1234);
+    const int64_t native = program(translated);
+
+    expectSameMachine(interpreted, translated);
+    EXPECT_LT(0, native);
+    EXPECT_EQ(361, translated.memory[1043].value());
+    EXPECT_EQ(0, translated.memory[1042].value());
+}
+
+TEST(TestTranslator, test_generated_source) {
+    mixal::Computer machine;
+    machine.loadCodes(SQUARES);
+    mixal::TranslationOptions options;
+    options.functionName = "squares";
+    const auto source = mixal::translateToCpp(machine, machine.line(), options);
+    EXPECT_NE(std::string::npos, source.find("extern \"C\" int64_t squares(mixal::Computer& machine)"));
+    EXPECT_NE(std::string::npos, source.find("L1000:"));
+    EXPECT_NE(std::string::npos, source.find("L1003:"));  // The return of SQR
+    EXPECT_NE(std::string::npos, source.find("case 1021: goto L1021;"));
+    EXPECT_EQ(std::string::npos, source.find("L1022:"));  // EXIT is modified by STJ
+    EXPECT_EQ(std::string::npos, source.find("L1023:"));
+    EXPECT_NE(std::string::npos, source.find("if (!R::same(machine, 1000, W[0]))"));
+    EXPECT_NE(std::string::npos, source.find("R::halt(machine);"));
+
+    machine.memory[1003] = mixal::ComputerWord(false, 0, 0, 0, 0, 0);
+    machine.memory[1004] = mixal::ComputerWord(false, 0, 0, 0, 0, 0);
+    const auto unguarded = mixal::translateToCpp(machine, machine.line());
+    EXPECT_NE(std::string::npos, unguarded.find("extern \"C\" int64_t mixal_translated(mixal::Computer& machine)"));
+    EXPECT_EQ(std::string::npos, unguarded.find("R::same"));
+}
+
+TEST(TestTranslator, test_stores_in_code_reached_by_computed_jumps) {
+    mixal::Computer machine;
+    machine.loadCodes({
+        "      ORIG 1000",
+        "START ENT1 1010",
+        "      J1Z  TGT",
+        "      JMP  0,1",
+        "TGT   INCA 1",
+        "      HLT",
+        "      ORIG 1010",
+        "      STZ  TGT",
+        "      JMP  TGT",
+        "      END  START",
+    });
+    const auto source = mixal::translateToCpp(machine, machine.line());
+    EXPECT_NE(std::string::npos, source.find("L1002:"));
+    EXPECT_EQ(std::string::npos, source.find("L1003:"));
+    EXPECT_NE(std::string::npos, source.find("L1004:"));
+    EXPECT_EQ(std::string::npos, source.find("R::same"));
+
+    machine.memory[1010] = mixal::ComputerWord(false, 0, 3, 1, 5, 33);  // STZ 3,1(0:5)
+    const auto guarded = mixal::translateToCpp(machine, machine.line());
+    EXPECT_NE(std::string::npos, guarded.find("L1003:"));
+    EXPECT_NE(std::string::npos, guarded.find("if (!R::same(machine, 1003, W[3]))"));
+}
@@ -0,0 +1,19 @@
+#include <fstream>
+#include <iostream>
+#include "translator.h"
+#include "squares.h"
+
+/** Write the translation of `SQUARES` for the byte size of the library to the given file. */
+int main(int argc, char **argv) {
+    if (argc != 2) {
+        std::cerr << "Usage: " << argv[0] << " OUTPUT" << std::endl;
+        return 1;
+    }
+    mixal::Computer machine;
+    machine.loadCodes(SQUARES);
+    mixal::TranslationOptions options;
+    options.functionName = "mixal_translated_squares";
+    std::ofstream out(argv[1]);
+    out << mixal::translateToCpp(machine, machine.line(), options);
+    return out ? 0 : 1;
+}
@@ -1,7 +1,11 @@
+#include <algorithm>
 #include <functional>
+#include <sstream>
 
 #include "machine.h"
 #include "parser.h"
+#include "timing.h"
+#include "translator.h"
 #include <string>
 #include <emscripten/bind.h>
 using namespace std;
@@ -40,7 +44,7 @@ EMSCRIPTEN_BINDINGS(MixalWASM) {
     ;
     class_<ComputerWord>("ComputerWord")
         .constructor<>()
-        .function("set", select_overload<void(int32_t)>(&ComputerWord::set))
+        .function("set", select_overload<void(WordValue)>(&ComputerWord::set))
         .function("setFloat", select_overload<bool(double)>(&ComputerWord::set))
         .function("setCharacters", select_overload<void(const string&)>(&ComputerWord::set))
         .function("setByteAt", select_overload<void(int, uint8_t)>(&ComputerWord::set))
@@ -58,6 +62,153 @@ EMSCRIPTEN_BINDINGS(MixalWASM) {
         .function("value", &Register2::value)
         .function("getBytesString", &Register2::getBytesString)
     ;
+    enum_<StopReason>("StopReason")
+        .value("HALT", StopReason::HALT)
+        .value("SELF_LOOP", StopReason::SELF_LOOP)
+        .value("BREAKPOINT", StopReason::BREAKPOINT)
+        .value("WATCH_READ", StopReason::WATCH_READ)
+        .value("WATCH_WRITE", StopReason::WATCH_WRITE)
+        .value("ERROR", StopReason::ERROR)
+        .value("BUDGET_EXHAUSTED", StopReason::BUDGET_EXHAUSTED)
+        .value("WAITING_FOR_INPUT", StopReason::WAITING_FOR_INPUT)
+        .value("RESOURCE_LIMIT", StopReason::RESOURCE_LIMIT)
+        .value("NON_TERMINATING_LOOP", StopReason::NON_TERMINATING_LOOP)
+    ;
+    enum_<ResourceKind>("ResourceKind")
+        .value("NONE", ResourceKind::NONE)
+        .value("PRINTED_LINES", ResourceKind::PRINTED_LINES)
+        .value("PUNCHED_CARDS", ResourceKind::PUNCHED_CARDS)
+        .value("TAPE_BLOCKS", ResourceKind::TAPE_BLOCKS)
+        .value("DISK_BLOCKS", ResourceKind::DISK_BLOCKS)
+        .value("MOVED_WORDS", ResourceKind::MOVED_WORDS)
+        .value("ELAPSED", ResourceKind::ELAPSED)
+        .value("WALL_CLOCK", ResourceKind::WALL_CLOCK)
+    ;
+    enum_<FaultCode>("FaultCode")
+        .value("NONE", FaultCode::NONE)
+        .value("INVALID_LINE", FaultCode::INVALID_LINE)
+        .value("INVALID_INDEX", FaultCode::INVALID_INDEX)
+        .value("INVALID_ADDRESS", FaultCode::INVALID_ADDRESS)
+        .value("INVALID_FIELD", FaultCode::INVALID_FIELD)
+        .value("DIVISION_BY_ZERO", FaultCode::DIVISION_BY_ZERO)
+        .value("FLOAT_DIVISION_BY_ZERO", FaultCode::FLOAT_DIVISION_BY_ZERO)
+        .value("INT_OUTSIDE_HANDLER", FaultCode::INT_OUTSIDE_HANDLER)
+        .value("READ_NOT_SUPPORTED", FaultCode::READ_NOT_SUPPORTED)
+        .value("WRITE_NOT_SUPPORTED", FaultCode::WRITE_NOT_SUPPORTED)
+        .value("BLOCK_OUT_OF_MEMORY", FaultCode::BLOCK_OUT_OF_MEMORY)
+        .value("RESOURCE_LIMIT", FaultCode::RESOURCE_LIMIT)
+        .value("INVALID_DEVICE", FaultCode::INVALID_DEVICE)
+        .value("NULL_DEVICE", FaultCode::NULL_DEVICE)
+    ;
+    value_object<Fault>("Fault")
+        .field("code", &Fault::code)
+        .field("line", &Fault::line)
+        .field("operand", &Fault::operand)
+        .field("blockSize", &Fault::blockSize)
+    ;
+    value_object<StopInfo>("StopInfo")
+        .field("reason", &StopInfo::reason)
+        .field("line", &StopInfo::line)
+        .field("address", &StopInfo::address)
+        .field("message", &StopInfo::message)
+        .field("resource", &StopInfo::resource)
+        .field("fault", &StopInfo::fault)
+    ;
+    value_object<ResourceLimits>("ResourceLimits")
+        .field("printedLines", &ResourceLimits::printedLines)
+        .field("punchedCards", &ResourceLimits::punchedCards)
+        .field("tapeBlocks", &ResourceLimits::tapeBlocks)
+        .field("diskBlocks", &ResourceLimits::diskBlocks)
+        .field("movedWords", &ResourceLimits::movedWords)
+        .field("elapsed", &ResourceLimits::elapsed)
+        .field("wallClockMilliseconds", &ResourceLimits::wallClockMilliseconds)
+        .field("wallClockCheckInterval", &ResourceLimits::wallClockCheckInterval)
+    ;
+    value_object<ResourceUsage>("ResourceUsage")
+        .field("printedLines", &ResourceUsage::printedLines)
+        .field("punchedCards", &ResourceUsage::punchedCards)
+        .field("tapeBlocks", &ResourceUsage::tapeBlocks)
+        .field("diskBlocks", &ResourceUsage::diskBlocks)
+        .field("movedWords", &ResourceUsage::movedWords)
+    ;
+    register_vector<int64_t>("Int64Vector");
+    value_object<PerformanceCounters>("PerformanceCounters")
+        .field("steps", &PerformanceCounters::steps)
+        .field("elapsed", &PerformanceCounters::elapsed)
+        .field("instructions", &PerformanceCounters::instructions)
+        .field("memoryReads", &PerformanceCounters::memoryReads)
+        .field("memoryWrites", &PerformanceCounters::memoryWrites)
+        .field("jumpsTaken", &PerformanceCounters::jumpsTaken)
+        .field("jumpsNotTaken", &PerformanceCounters::jumpsNotTaken)
+        .field("overflows", &PerformanceCounters::overflows)
+        .field("movedWords", &PerformanceCounters::movedWords)
+        .field("deviceWaitCycles", &PerformanceCounters::deviceWaitCycles)
+        .field("deviceInputWords", &PerformanceCounters::deviceInputWords)
+        .field("deviceOutputWords", &PerformanceCounters::deviceOutputWords)
+    ;
+    register_vector<int32_t>("Int32Vector");
+    register_vector<std::string>("StringVector");
+    register_map<std::string, int64_t>("Int64Map");
+    value_object<CostTerm>("CostTerm")
+        .field("coefficient", &CostTerm::coefficient)
+        .field("symbols", &CostTerm::symbols)
+    ;
+    register_vector<CostTerm>("CostTermVector");
+    class_<CostExpression>("CostExpression")
+        .property("terms", &CostExpression::terms)
+        .function("evaluate", &CostExpression::evaluate)
+        .function("toString", &CostExpression::toString)
+    ;
+    value_object<TimingBlock>("TimingBlock")
+        .field("start", &TimingBlock::start)
+        .field("length", &TimingBlock::length)
+        .field("cost", &TimingBlock::cost)
+        .field("successors", &TimingBlock::successors)
+        .field("loop", &TimingBlock::loop)
+        .field("count", &TimingBlock::count)
+    ;
+    register_vector<TimingBlock>("TimingBlockVector");
+    value_object<TimingLoop>("TimingLoop")
+        .field("header", &TimingLoop::header)
+        .field("latch", &TimingLoop::latch)
+        .field("parent", &TimingLoop::parent)
+        .field("counter", &TimingLoop::counter)
+        .field("iterations", &TimingLoop::iterations)
+        .field("symbol", &TimingLoop::symbol)
+        .field("blocks", &TimingLoop::blocks)
+        .field("cost", &TimingLoop::cost)
+    ;
+    register_vector<TimingLoop>("TimingLoopVector");
+    class_<TimingAnalysis>("TimingAnalysis")
+        .property("blocks", &TimingAnalysis::blocks)
+        .property("loops", &TimingAnalysis::loops)
+        .property("cost", &TimingAnalysis::cost)
+        .function("estimate", &TimingAnalysis::estimate)
+    ;
+    enum_<RegisterName>("RegisterName")
+        .value("A", RegisterName::A)
+        .value("X", RegisterName::X)
+        .value("I1", RegisterName::I1)
+        .value("I2", RegisterName::I2)
+        .value("I3", RegisterName::I3)
+        .value("I4", RegisterName::I4)
+        .value("I5", RegisterName::I5)
+        .value("I6", RegisterName::I6)
+        .value("J", RegisterName::J)
+    ;
+    enum_<ConditionOperator>("ConditionOperator")
+        .value("EQUAL", ConditionOperator::EQUAL)
+        .value("NOT_EQUAL", ConditionOperator::NOT_EQUAL)
+        .value("LESS", ConditionOperator::LESS)
+        .value("LESS_EQUAL", ConditionOperator::LESS_EQUAL)
+        .value("GREATER", ConditionOperator::GREATER)
+        .value("GREATER_EQUAL", ConditionOperator::GREATER_EQUAL)
+    ;
+    value_object<BreakpointCondition>("BreakpointCondition")
+        .field("reg", &BreakpointCondition::reg)
+        .field("op", &BreakpointCondition::op)
+        .field("value", &BreakpointCondition::value)
+    ;
     class_<Computer>("Computer")
         .constructor<>()
         .function("registerA", &Computer::registerA, return_value_policy::reference())
@@ -73,12 +224,98 @@ EMSCRIPTEN_BINDINGS(MixalWASM) {
         .function("_loadCodes", select_overload<void(const string&, bool)>(&Computer::loadCodes))
         .function("memoryAt", static_cast<ComputerWord&(Computer::*)(int16_t)>(&Computer::memoryAt), return_value_policy::reference())
         .function("getDeviceWordAt", &Computer::getDeviceWordAt, return_value_policy::reference())
+        .function("mapDeviceFile", &Computer::mapDeviceFile)
+        .function("unmapDeviceFile", &Computer::unmapDeviceFile)
+        .function("setDeviceSourceText", optional_override([](Computer& computer, const int32_t device, const string& text) {
+            computer.setDeviceSource(device, std::make_shared<TextBlockSource>(std::make_unique<std::istringstream>(text)));
+        }))
+        .function("setDeviceSink", optional_override([](Computer& computer, const int32_t device, val callback) {
+            computer.setDeviceSink(device, std::make_shared<TextBlockSink>([callback](const string& line) {
+                callback(line);
+            }));
+        }))
+        .function("registerDevice", optional_override([](Computer& computer, const int32_t device, const int32_t blockSize,
+                                                         val read, val write) {
+            computer.registerDevice(device, [=]() {
+                IODeviceCallback::ReadCallback onRead;
+                IODeviceCallback::WriteCallback onWrite;
+                if (!read.isUndefined() && !read.isNull()) {
+                    onRead = [read](std::span<ComputerWord> block) {
+                        const val values = read();
+                        if (values.isUndefined() || values.isNull() || values.isFalse()) {
+                            return false;
+                        }
+                        const auto length = std::min<size_t>(values["length"].as<size_t>(), block.size());
+                        for (size_t i = 0; i < length; ++i) {
+                            block[i].set(values[i].as<int32_t>());
+                        }
+                        return true;
+                    };
+                }
+                if (!write.isUndefined() && !write.isNull()) {
+                    onWrite = [write](std::span<const ComputerWord> block) {
+                        val values = val::array();
+                        for (const auto& word : block) {
+                            values.call<void>("push", word.value());
+                        }
+                        write(values);
+                    };
+                }
+                return std::make_unique<IODeviceCallback>(blockSize, onRead, onWrite);
+            });
+        }))
+        .function("unregisterDevice", optional_override([](Computer& computer, const int32_t device) {
+            computer.registerDevice(device, nullptr);
+        }))
+        .function("hasRegisteredDevice", &Computer::hasRegisteredDevice)
         .function("executeSingle", select_overload<void()>(&Computer::executeSingle))
         .function("executeUntilSelfLoop", &Computer::executeUntilSelfLoop)
         .function("executeUntilHalt", &Computer::executeUntilHalt)
         .function("executeUntilHaltOrSelfLoop", &Computer::executeUntilHaltOrSelfLoop)
         .function("getDeviceWordAt", &Computer::getDeviceWordAt, return_value_policy::reference())
+        .function("setBreakpoint", select_overload<void(int32_t)>(&Computer::setBreakpoint))
+        .function("setConditionalBreakpoint", select_overload<void(int32_t, const BreakpointCondition&)>(&Computer::setBreakpoint))
+        .function("clearBreakpoint", &Computer::clearBreakpoint)
+        .function("clearBreakpoints", &Computer::clearBreakpoints)
+        .function("hasBreakpoint", &Computer::hasBreakpoint)
+        .function("setWatchpoint", &Computer::setWatchpoint)
+        .function("clearWatchpoint", &Computer::clearWatchpoint)
+        .function("clearWatchpoints", &Computer::clearWatchpoints)
+        .function("setResourceLimits", &Computer::setResourceLimits)
+        .function("clearResourceLimits", &Computer::clearResourceLimits)
+        .function("resourceLimits", &Computer::resourceLimits)
+        .function("resourceUsage", &Computer::resourceUsage)
+        .function("setLoopDetection", &Computer::setLoopDetection)
+        .function("loopDetection", &Computer::loopDetection)
+        .function("setIdleFastForward", &Computer::setIdleFastForward)
+        .function("idleFastForward", &Computer::idleFastForward)
+        .function("setInterruptVector", &Computer::setInterruptVector)
+        .function("interruptVector", &Computer::interruptVector)
+        .function("inControlState", &Computer::inControlState)
+        .function("_run", &Computer::run)
+        .function("runUntilBreak", &Computer::runUntilBreak)
         .function("line", &Computer::line)
-        .function("elapsed", &Computer::elapsed)
+        .function("elapsed", optional_override([](const Computer& computer) {
+            return static_cast<double>(computer.elapsed());
+        }))
+        .function("steps", optional_override([](const Computer& computer) {
+            return static_cast<double>(computer.steps());
+        }))
+        .function("setCountersEnabled", &Computer::setCountersEnabled)
+        .function("countersEnabled", &Computer::countersEnabled)
+        .function("performanceCounters", &Computer::performanceCounters)
+        .function("resetPerformanceCounters", &Computer::resetPerformanceCounters)
+        .function("setDeviceTraceCapacity", &Computer::setDeviceTraceCapacity)
+        .function("clearDeviceTrace", &Computer::clearDeviceTrace)
+        .function("deviceTraceJson", optional_override([](const Computer& computer) {
+            return computer.deviceTrace().toChromeTrace();
+        }))
+        .function("translateToCpp", optional_override([](const Computer& computer, int32_t entry,
+                                                          const std::string& functionName) {
+            TranslationOptions options;
+            options.functionName = functionName;
+            return translateToCpp(computer, entry, options);
+        }))
+        .function("analyzeTiming", &analyzeTiming)
     ;
 }
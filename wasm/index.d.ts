@@ -61,6 +61,198 @@ declare module 'mixal' {
         getBytesString(): string
     }
 
+    export interface EnumValue {
+        value: number
+    }
+
+    export interface StopReasonConstructor {
+        HALT: EnumValue
+        SELF_LOOP: EnumValue
+        BREAKPOINT: EnumValue
+        WATCH_READ: EnumValue
+        WATCH_WRITE: EnumValue
+        ERROR: EnumValue
+        BUDGET_EXHAUSTED: EnumValue
+        WAITING_FOR_INPUT: EnumValue
+        RESOURCE_LIMIT: EnumValue
+        NON_TERMINATING_LOOP: EnumValue
+    }
+
+    export const StopReason: StopReasonConstructor
+
+    export interface ResourceKindConstructor {
+        NONE: EnumValue
+        PRINTED_LINES: EnumValue
+        PUNCHED_CARDS: EnumValue
+        TAPE_BLOCKS: EnumValue
+        DISK_BLOCKS: EnumValue
+        MOVED_WORDS: EnumValue
+        ELAPSED: EnumValue
+        WALL_CLOCK: EnumValue
+    }
+
+    export const ResourceKind: ResourceKindConstructor
+
+    export interface ResourceLimits {
+        printedLines: bigint
+        punchedCards: bigint
+        tapeBlocks: bigint
+        diskBlocks: bigint
+        movedWords: bigint
+        elapsed: bigint
+        wallClockMilliseconds: bigint
+        wallClockCheckInterval: bigint
+    }
+
+    export interface ResourceUsage {
+        printedLines: bigint
+        punchedCards: bigint
+        tapeBlocks: bigint
+        diskBlocks: bigint
+        movedWords: bigint
+    }
+
+    export interface Int64Vector {
+        size(): number
+        get(index: number): bigint
+    }
+
+    export interface PerformanceCounters {
+        steps: bigint
+        elapsed: bigint
+        instructions: Int64Vector
+        memoryReads: bigint
+        memoryWrites: bigint
+        jumpsTaken: bigint
+        jumpsNotTaken: bigint
+        overflows: bigint
+        movedWords: bigint
+        deviceWaitCycles: Int64Vector
+        deviceInputWords: Int64Vector
+        deviceOutputWords: Int64Vector
+    }
+
+    export interface Int32Vector {
+        size(): number
+        get(index: number): number
+    }
+
+    export interface StringVector {
+        size(): number
+        get(index: number): string
+    }
+
+    export class Int64Map {
+        constructor()
+        set(key: string, value: bigint): void
+        get(key: string): bigint | undefined
+        size(): number
+    }
+
+    export interface CostTerm {
+        coefficient: bigint
+        symbols: StringVector
+    }
+
+    export interface CostExpression {
+        terms: { size(): number, get(index: number): CostTerm }
+        evaluate(values: Int64Map): bigint
+        toString(): string
+    }
+
+    export interface TimingBlock {
+        start: number
+        length: number
+        cost: bigint
+        successors: Int32Vector
+        loop: number
+        count: CostExpression
+    }
+
+    export interface TimingLoop {
+        header: number
+        latch: number
+        parent: number
+        counter: number
+        iterations: bigint
+        symbol: string
+        blocks: Int32Vector
+        cost: CostExpression
+    }
+
+    export interface TimingAnalysis {
+        blocks: { size(): number, get(index: number): TimingBlock }
+        loops: { size(): number, get(index: number): TimingLoop }
+        cost: CostExpression
+        estimate(iterations: Int64Map): bigint
+    }
+
+    export interface FaultCodeConstructor {
+        NONE: EnumValue
+        INVALID_LINE: EnumValue
+        INVALID_INDEX: EnumValue
+        INVALID_ADDRESS: EnumValue
+        INVALID_FIELD: EnumValue
+        DIVISION_BY_ZERO: EnumValue
+        FLOAT_DIVISION_BY_ZERO: EnumValue
+        INT_OUTSIDE_HANDLER: EnumValue
+        READ_NOT_SUPPORTED: EnumValue
+        WRITE_NOT_SUPPORTED: EnumValue
+        BLOCK_OUT_OF_MEMORY: EnumValue
+        RESOURCE_LIMIT: EnumValue
+        INVALID_DEVICE: EnumValue
+        NULL_DEVICE: EnumValue
+    }
+
+    export const FaultCode: FaultCodeConstructor
+
+    export interface Fault {
+        code: EnumValue
+        line: number
+        operand: number
+        blockSize: number
+    }
+
+    export interface StopInfo {
+        reason: EnumValue
+        line: number
+        address: number
+        message: string
+        resource: EnumValue
+        fault: Fault
+    }
+
+    export interface RegisterNameConstructor {
+        A: EnumValue
+        X: EnumValue
+        I1: EnumValue
+        I2: EnumValue
+        I3: EnumValue
+        I4: EnumValue
+        I5: EnumValue
+        I6: EnumValue
+        J: EnumValue
+    }
+
+    export const RegisterName: RegisterNameConstructor
+
+    export interface ConditionOperatorConstructor {
+        EQUAL: EnumValue
+        NOT_EQUAL: EnumValue
+        LESS: EnumValue
+        LESS_EQUAL: EnumValue
+        GREATER: EnumValue
+        GREATER_EQUAL: EnumValue
+    }
+
+    export const ConditionOperator: ConditionOperatorConstructor
+
+    export interface BreakpointCondition {
+        reg: EnumValue
+        op: EnumValue
+        value: number
+    }
+
     export class Computer {
         constructor()
         registerA(): Register5
@@ -77,13 +269,54 @@ declare module 'mixal' {
         loadCodes(code: string, addHalt?: boolean): void
         memoryAt(index: number): ComputerWord
         getDeviceWordAt(device: number, index: number): ComputerWord
+        mapDeviceFile(device: number, path: string): void
+        unmapDeviceFile(device: number): void
+        setDeviceSourceText(device: number, text: string): void
+        setDeviceSink(device: number, callback: (line: string) => void): void
+        registerDevice(device: number, blockSize: number,
+                       read: (() => number[] | null | false) | null,
+                       write: ((block: number[]) => void) | null): void
+        unregisterDevice(device: number): void
+        hasRegisteredDevice(device: number): boolean
         executeSingle(): void
         executeUntilSelfLoop(): void
         executeUntilHalt(): void
         executeUntilHaltOrSelfLoop(): void
         getDeviceWordAt(device: number, index: number): ComputerWord
+        setBreakpoint(address: number): void
+        setConditionalBreakpoint(address: number, condition: BreakpointCondition): void
+        clearBreakpoint(address: number): void
+        clearBreakpoints(): void
+        hasBreakpoint(address: number): boolean
+        setWatchpoint(address: number, onRead: boolean, onWrite: boolean): void
+        clearWatchpoint(address: number): void
+        clearWatchpoints(): void
+        setResourceLimits(limits: ResourceLimits): void
+        clearResourceLimits(): void
+        resourceLimits(): ResourceLimits
+        resourceUsage(): ResourceUsage
+        setLoopDetection(enabled: boolean): void
+        loopDetection(): boolean
+        setIdleFastForward(enabled: boolean): void
+        idleFastForward(): boolean
+        setInterruptVector(address: number): void
+        interruptVector(): number
+        inControlState(): boolean
+        _run(maxSteps: bigint, maxElapsed: bigint): StopInfo
+        run(maxSteps?: number | bigint, maxElapsed?: number | bigint): StopInfo
+        runUntilBreak(): StopInfo
         line(): number
         elapsed(): number
+        steps(): number
+        setCountersEnabled(enabled: boolean): void
+        countersEnabled(): boolean
+        performanceCounters(): PerformanceCounters
+        resetPerformanceCounters(): void
+        setDeviceTraceCapacity(capacity: number): void
+        clearDeviceTrace(): void
+        deviceTraceJson(): string
+        translateToCpp(entry: number, functionName: string): string
+        analyzeTiming(entry: number): TimingAnalysis
     }
 
     export function executeWithSpec(code: string, ioSpec: Record<string, Record<string, any>>): Record<string, any>
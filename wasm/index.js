@@ -8,9 +8,16 @@ const Register2 = MixalWASM.Register2;
 const Computer = MixalWASM.Computer;
 const Parser = MixalWASM.Parser;
 const ParsedType = MixalWASM.ParsedType;
+const StopReason = MixalWASM.StopReason;
+const RegisterName = MixalWASM.RegisterName;
+const ConditionOperator = MixalWASM.ConditionOperator;
+const ResourceKind = MixalWASM.ResourceKind;
 Computer.prototype.loadCodes = function(code, addHalt = true) {
     this._loadCodes(code, addHalt);
 };
+Computer.prototype.run = function(maxSteps = -1, maxElapsed = -1) {
+    return this._run(BigInt(maxSteps), BigInt(maxElapsed));
+};
 
 let DEVICE_NAME_MAPPING = {};
 let RANDOM_ACCESS_NAMES = [];
@@ -234,4 +241,8 @@ export {
     Computer,
     Parser,
     ParsedType,
+    StopReason,
+    RegisterName,
+    ConditionOperator,
+    ResourceKind,
 };